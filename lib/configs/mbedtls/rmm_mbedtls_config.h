@@ -64,6 +64,13 @@
 #define MBEDTLS_SHA384_C
 #define MBEDTLS_SHA512_C
 
+/*
+ * SHA-256/SHA-512 block functions are provided by plat/common/src/pal_sha2.c,
+ * which uses the Armv8 crypto extension when the PE implements it.
+ */
+#define MBEDTLS_SHA256_PROCESS_ALT
+#define MBEDTLS_SHA512_PROCESS_ALT
+
 #define MBEDTLS_VERSION_C
 
 /*
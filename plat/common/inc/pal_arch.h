@@ -203,6 +203,11 @@
 #define ID_AA64PFR0_GIC_WIDTH    U(4)
 #define ID_AA64PFR0_GIC_MASK    ULL(0xf)
 
+/* ID_AA64ISAR2_EL1 definitions */
+#define ID_AA64ISAR2_EL1    S3_0_C0_C6_2
+#define ID_AA64ISAR2_MOPS_SHIFT    U(16)
+#define ID_AA64ISAR2_MOPS_MASK    ULL(0xf)
+
 /* ID_AA64ISAR1_EL1 definitions */
 #define ID_AA64ISAR1_EL1    S3_0_C0_C6_1
 #define ID_AA64ISAR1_GPI_SHIFT    U(28)
@@ -661,6 +666,13 @@
 
 #define MAX_CACHE_LINE_SIZE    U(0x800) /* 2KB */
 
+/*
+ * DCZID_EL0 definitions
+ */
+#define DCZID_BS_SHIFT        U(0)
+#define DCZID_BS_MASK        U(0xf)
+#define DCZID_DZP_BIT        (U(1) << 4)
+
 /* Physical timer control register bit fields shifts and masks */
 #define CNTP_CTL_ENABLE_SHIFT   U(0)
 #define CNTP_CTL_IMASK_SHIFT    U(1)
@@ -1165,6 +1177,12 @@
 #define ID_AA64ISAR0_EL1_RNDR_SHIFT		UL(60)
 #define ID_AA64ISAR0_EL1_RNDR_WIDTH		UL(4)
 
+/* SHA2 definitions */
+#define ID_AA64ISAR0_EL1_SHA2_SHIFT		UL(12)
+#define ID_AA64ISAR0_EL1_SHA2_MASK		UL(0xf)
+#define ID_AA64ISAR0_EL1_SHA2_SHA256		UL(0x1)
+#define ID_AA64ISAR0_EL1_SHA2_SHA512		UL(0x2)
+
 /* ID_AA64MMFR1_EL1 definitions */
 #define ID_AA64MMFR1_EL1_VMIDBits_SHIFT		UL(4)
 #define ID_AA64MMFR1_EL1_VMIDBits_WIDTH		UL(4)
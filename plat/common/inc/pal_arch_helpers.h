@@ -184,6 +184,7 @@ void disable_mmu_icache(void);
 
 DEFINE_SYSREG_RW_FUNCS(par_el1)
 DEFINE_SYSREG_READ_FUNC(id_pfr1_el1)
+DEFINE_SYSREG_READ_FUNC(id_aa64isar0_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64isar1_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64pfr0_el1)
 DEFINE_SYSREG_READ_FUNC(id_aa64pfr1_el1)
@@ -191,6 +192,7 @@ DEFINE_SYSREG_READ_FUNC(id_aa64dfr0_el1)
 DEFINE_SYSREG_READ_FUNC(id_afr0_el1)
 DEFINE_SYSREG_READ_FUNC(CurrentEl)
 DEFINE_SYSREG_READ_FUNC(ctr_el0)
+DEFINE_SYSREG_READ_FUNC(dczid_el0)
 DEFINE_SYSREG_RW_FUNCS(daif)
 DEFINE_SYSREG_RW_FUNCS(nzcv)
 DEFINE_SYSREG_READ_FUNC(spsel)
@@ -380,6 +382,7 @@ DEFINE_SYSREG_RW_FUNCS(cntv_ctl_el0)
 DEFINE_SYSREG_RW_FUNCS(cntv_tval_el0)
 DEFINE_SYSREG_RW_FUNCS(cntv_cval_el0)
 DEFINE_SYSREG_RW_FUNCS(cnthctl_el2)
+DEFINE_SYSREG_RW_FUNCS(cntkctl_el1)
 
 #define get_cntp_ctl_enable(x)  (((x) >> CNTP_CTL_ENABLE_SHIFT) & \
                     CNTP_CTL_ENABLE_MASK)
@@ -514,6 +517,9 @@ DEFINE_RENAME_SYSREG_RW_FUNCS(pan, PAN)
 /* Armv8.2 Registers */
 DEFINE_RENAME_SYSREG_READ_FUNC(id_aa64mmfr2_el1, ID_AA64MMFR2_EL1)
 
+/* Armv8.8 Registers */
+DEFINE_RENAME_SYSREG_READ_FUNC(id_aa64isar2_el1, ID_AA64ISAR2_EL1)
+
 /* Armv8.3 Pointer Authentication Registers */
 /* Instruction keys A and B */
 DEFINE_RENAME_SYSREG_RW_FUNCS(apiakeyhi_el1, APIAKeyHi_EL1)
@@ -45,6 +45,9 @@ typedef char     char8_t;
 
 #define PCIE_CREATE_BDF(Seg, Bus, Dev, Func) ((Seg << 16) | (Bus << 8) | (Dev << 3) | Func)
 
+/* Offset of a function config space from the ECAM base, Bus/Dev/Func of the bdf */
+#define PCIE_CFG_OFFSET(bdf)     ((uint64_t)((bdf) & 0xFFFF) << 12)
+
 #define PCIE_SUCCESS            0x00000000  /* Operation completed successfully */
 #define PCIE_NO_MAPPING         0x10000001  /* A mapping to a Function does not exist */
 #define PCIE_CAP_NOT_FOUND      0x10000010  /* The specified capability was not found */
@@ -174,6 +177,15 @@ typedef struct __attribute__((packed)) {
     PCIE_INFO_BLOCK block[];
 } PCIE_INFO_TABLE;
 
+/**
+  @brief  Per-bus ECAM map filled with the info table. A bus is mapped to the
+          first ECAM block covering it, ecam_base is 0 for unmapped buses.
+**/
+typedef struct {
+    uint64_t   ecam_base[PCIE_MAX_BUS];
+    uint8_t    segment[PCIE_MAX_BUS];
+} PCIE_CFG_MAP;
+
 typedef struct {
     uint64_t   class_code;
     uint32_t   device_id;
@@ -204,6 +216,34 @@ typedef struct __attribute__((packed)) {
     pcie_device_attr device[];    /* in the format of Segment/Bus/Dev/Func */
 } pcie_device_bdf_table;
 
+/* Maximum number of functions recorded during enumeration */
+#define PCIE_DEV_TABLE_MAX_ENTRIES  256
+#define PCIE_DEV_MAX_BARS           6
+
+/**
+  @brief  Function discovered during enumeration. BAR slots hold the programmed
+          base address and size; the upper slot of a 64-bit BAR stays zero.
+**/
+typedef struct {
+    uint32_t   bdf;                          /* Segment/Bus/Dev/Func */
+    uint32_t   id;                           /* Device ID << 16 | Vendor ID */
+    uint32_t   class_code;                   /* Class code << 8 | Revision ID */
+    uint32_t   header_type;                  /* TYPE0_HEADER or TYPE1_HEADER */
+    uint64_t   bar_base[PCIE_DEV_MAX_BARS];
+    uint64_t   bar_size[PCIE_DEV_MAX_BARS];
+} PCIE_DEV_ENTRY;
+
+/**
+  @brief  Device table filled in a single enumeration pass, with entry indices
+          sorted by BDF and by (class code, BDF) for binary search lookups.
+**/
+typedef struct {
+    uint32_t        num_entries;
+    uint16_t        bdf_index[PCIE_DEV_TABLE_MAX_ENTRIES];
+    uint16_t        class_index[PCIE_DEV_TABLE_MAX_ENTRIES];
+    PCIE_DEV_ENTRY  device[PCIE_DEV_TABLE_MAX_ENTRIES];
+} PCIE_DEV_TABLE;
+
 
 typedef struct {
     uint32_t    num_usb;   /* Number of USB  Controllers */
@@ -375,6 +415,7 @@ uint32_t pal_pcie_check_device_valid(uint32_t bdf);
 uint32_t pal_pcie_mem_get_offset(uint32_t bdf, PCIE_MEM_TYPE_INFO_e mem_type);
 
 void     pal_pcie_create_info_table(PCIE_INFO_TABLE *PcieTable);
+PCIE_CFG_MAP *pal_pcie_get_cfg_map(void);
 uint64_t pal_pcie_ecam_base(uint32_t seg, uint32_t bus, uint32_t dev, uint32_t func);
 uint32_t pal_pcie_get_pcie_type(uint32_t seg, uint32_t bus, uint32_t dev, uint32_t fn);
 uint32_t pal_pcie_get_snoop_bit(uint32_t seg, uint32_t bus, uint32_t dev, uint32_t fn);
@@ -399,8 +440,10 @@ void pal_pcie_rp_program_bar(uint32_t bus, uint32_t dev, uint32_t func);
 uint32_t pal_is_bdf_exerciser(uint32_t bdf);
 void pal_pcie_program_bar_reg(uint32_t bus, uint32_t dev, uint32_t func);
 uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus);
-void pal_clear_pri_bus(void);
 void pal_pcie_enumerate(void);
+PCIE_DEV_TABLE *pal_pcie_get_dev_table(void);
+void pal_pcie_enumerate_restore(void);
+PCIE_DEV_ENTRY *pal_pcie_find_dev(uint32_t bdf);
 uint32_t pal_pcie_get_bdf_wrapper(uint32_t class_code, uint32_t start_bdf);
 void *pal_pci_bdf_to_dev(uint32_t bdf);
 uint64_t pal_exerciser_get_pcie_config_offset(uint32_t Bdf);
@@ -10,8 +10,37 @@
 
 #include "mbedtls/x509_crt.h"
 #include "mbedtls/oid.h"
+#include "pal.h"
+#include "pal_interfaces.h"
+
+/* ECDSA P-384 with SHA-384 */
+#define PAL_P384_COORD_SIZE             48U
+#define PAL_P384_POINT_SIZE             (1U + 2U * PAL_P384_COORD_SIZE)
+#define PAL_SHA384_SIZE                 48U
+
+/* Number of parsed public keys kept by pal_cose_sign1_verify_p384() */
+#define PAL_KEY_CACHE_ENTRIES           4U
+
+/* SHA-2 block backends reported by pal_sha2_backend_get() */
+#define PAL_SHA2_BACKEND_C              0x0U
+#define PAL_SHA2_BACKEND_CE_SHA256      0x1U
+#define PAL_SHA2_BACKEND_CE_SHA512      0x2U
+
+/* Algorithms of pal_sha2_digest() */
+#define PAL_SHA2_ALG_SHA256             0x0U
+#define PAL_SHA2_ALG_SHA384             0x1U
+#define PAL_SHA2_ALG_SHA512             0x2U
+#define PAL_SHA2_DIGEST_SIZE(alg)       ((alg) == PAL_SHA2_ALG_SHA256 ? 32U : \
+                                         (alg) == PAL_SHA2_ALG_SHA384 ? 48U : 64U)
 
 int pal_mbedtls_x509_crt_parse(mbedtls_x509_crt * chain, const unsigned char *buf, size_t cert_len);
 int pal_mbedtls_oid_get_sig_alg_desc(const mbedtls_asn1_buf *oid, const char **desc);
+uint32_t pal_cose_sign1_verify_p384(const pal_cose_sign1_ts *sign1,
+                                    const uint8_t *point, size_t point_len);
+uint32_t pal_sha2_backend_get(void);
+void pal_sha256_blocks_ce(uint32_t state[8], const uint8_t *data, size_t blocks);
+void pal_sha512_blocks_ce(uint64_t state[8], const uint8_t *data, size_t blocks);
+uint32_t pal_sha2_digest(uint32_t backend, uint32_t alg, const uint8_t *data,
+                         size_t len, uint8_t *digest);
 
 #endif /* _PAL_CRYPTO_H_ */
\ No newline at end of file
@@ -98,6 +98,18 @@ uint32_t pal_twdog_enable(uint32_t ms);
 **/
 uint32_t pal_twdog_disable(void);
 
-uint32_t pal_verify_signature(uint64_t *token);
+/* Parts of a COSE_Sign1 structure, as decoded from an attestation token */
+typedef struct {
+    const uint8_t *protected_hdr;
+    size_t protected_len;
+    const uint8_t *payload;
+    size_t payload_len;
+    const uint8_t *signature;
+    size_t signature_len;
+} pal_cose_sign1_ts;
+
+uint32_t pal_verify_signature(const pal_cose_sign1_ts *platform_token,
+                              const pal_cose_sign1_ts *realm_token,
+                              const uint8_t *rak, size_t rak_len);
 
 #endif /* _PAL_INTERFACES_H_ */
@@ -12,6 +12,9 @@
 
 #define assert(e)   ((e) ? (void)0 : pal_assert(#e, __LINE__, __FILE__))
 
+/* Below this size the MOPS prologue costs more than the inline word loops */
+#define PAL_MOPS_MIN_LEN        64U
+
 #define CASSERT(cond, msg)    \
     typedef char msg[(cond) ? 1 : -1] __unused
 
@@ -33,6 +36,14 @@ int pal_memcmp(void *src, void *dest, size_t len);
 **/
 void *pal_memset(void *dst, int val, size_t count);
 
+/**
+ * @brief        - Zero a buffer, by DC ZVA blocks where the PE permits it
+ * @param        - dst: Pointer to the buffer to zero, in Normal memory
+ * @param        - count: Number of bytes in buffer to zero
+ * @return       - dst
+**/
+void *pal_memzero(void *dst, size_t count);
+
 /**
  * @brief        - Copy src buffer content into dst
  * @param        - dst: Pointer to the destination buffer
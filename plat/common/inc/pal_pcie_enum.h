@@ -30,6 +30,11 @@
 #define TYPE01_RIDR        0x8
 
 #define PCIE_HEADER_TYPE(header_value) ((header_value >> 16) & 0x3)
+#define PCIE_MULTI_FUNC(header_value)  ((header_value >> 23) & 0x1)
+
+/* Sort key of the device table class index: base and sub class, then BDF */
+#define PCIE_DEV_CLASS_KEY(entry) \
+        (((uint64_t)((entry)->class_code >> CC_SUB_SHIFT) << 32) | (entry)->bdf)
 #define BUS_NUM_REG_CFG(sub_bus, sec_bus, pri_bus) (sub_bus << 16 | sec_bus << 8 | bus)
 
 #define DEVICE_ID_OFFSET   16
@@ -6,6 +6,23 @@
  */
 
 #include "pal_crypto.h"
+#include "pal_libc.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/sha512.h"
+
+/* CBOR major type of a byte string, used to encode the Sig_structure */
+#define PAL_CBOR_BSTR           2U
+
+typedef struct {
+    uint8_t key_hash[PAL_SHA384_SIZE];
+    mbedtls_ecp_point q;
+    bool valid;
+} pal_key_cache_ts;
+
+static mbedtls_ecp_group pal_p384_grp;
+static bool pal_p384_grp_valid;
+static pal_key_cache_ts pal_key_cache[PAL_KEY_CACHE_ENTRIES];
+static uint32_t pal_key_cache_next;
 
 /**
   @brief  Call the mbedtls certificate parse function
@@ -27,4 +44,138 @@ int pal_mbedtls_x509_crt_parse(mbedtls_x509_crt *chain, const unsigned char *buf
 int pal_mbedtls_oid_get_sig_alg_desc(const mbedtls_asn1_buf *oid, const char **desc)
 {
     return mbedtls_oid_get_sig_alg_desc(oid, desc);
-}
\ No newline at end of file
+}
+
+/**
+  @brief  Encode the head of a CBOR item
+  @param  buf    - output buffer of at least 9 bytes
+  @param  major  - major type of the item
+  @param  val    - argument of the head
+  @return Returns the length of the head
+**/
+static size_t pal_cbor_put_head(uint8_t *buf, uint8_t major, uint64_t val)
+{
+    size_t n, i;
+
+    if (val < 24U)
+    {
+        buf[0] = (uint8_t)((major << 5) | val);
+        return 1;
+    }
+
+    n = (val <= 0xffU) ? 1U : (val <= 0xffffU) ? 2U : (val <= 0xffffffffU) ? 4U : 8U;
+    buf[0] = (uint8_t)((major << 5) | (n == 1U ? 24U : n == 2U ? 25U : n == 4U ? 26U : 27U));
+    for (i = 0; i < n; i++)
+        buf[n - i] = (uint8_t)(val >> (8U * i));
+
+    return n + 1U;
+}
+
+/**
+  @brief  Get the parsed form of a P-384 public key. Keys are cached by their
+          SHA-384 hash so that repeated verifications skip parsing and the
+          on-curve check.
+  @param  point      - uncompressed point
+  @param  point_len  - size of the point
+  @return Returns the parsed key, NULL if the key is invalid
+**/
+static const mbedtls_ecp_point *pal_p384_key_get(const uint8_t *point, size_t point_len)
+{
+    uint8_t key_hash[PAL_SHA384_SIZE];
+    pal_key_cache_ts *entry;
+    uint32_t i;
+
+    if (!pal_p384_grp_valid)
+    {
+        mbedtls_ecp_group_init(&pal_p384_grp);
+        if (mbedtls_ecp_group_load(&pal_p384_grp, MBEDTLS_ECP_DP_SECP384R1))
+            return NULL;
+        pal_p384_grp_valid = true;
+    }
+
+    if (mbedtls_sha512(point, point_len, key_hash, 1))
+        return NULL;
+
+    for (i = 0; i < PAL_KEY_CACHE_ENTRIES; i++)
+    {
+        if (pal_key_cache[i].valid &&
+            !pal_memcmp(pal_key_cache[i].key_hash, key_hash, PAL_SHA384_SIZE))
+            return &pal_key_cache[i].q;
+    }
+
+    /* Replace the cache entries round robin */
+    entry = &pal_key_cache[pal_key_cache_next];
+    pal_key_cache_next = (pal_key_cache_next + 1U) % PAL_KEY_CACHE_ENTRIES;
+
+    if (entry->valid)
+        mbedtls_ecp_point_free(&entry->q);
+
+    entry->valid = false;
+    mbedtls_ecp_point_init(&entry->q);
+    if (mbedtls_ecp_point_read_binary(&pal_p384_grp, &entry->q, point, point_len) ||
+        mbedtls_ecp_check_pubkey(&pal_p384_grp, &entry->q))
+    {
+        mbedtls_ecp_point_free(&entry->q);
+        return NULL;
+    }
+
+    pal_memcpy(entry->key_hash, key_hash, PAL_SHA384_SIZE);
+    entry->valid = true;
+    return &entry->q;
+}
+
+/**
+  @brief  Verify the ES384 signature of a COSE_Sign1 structure. The Sig_structure
+          is hashed in place without being assembled in memory.
+  @param  sign1      - protected header, payload and signature of the structure
+  @param  point      - uncompressed P-384 public key
+  @param  point_len  - size of the key
+  @return Returns PAL_SUCCESS or PAL_ERROR
+**/
+uint32_t pal_cose_sign1_verify_p384(const pal_cose_sign1_ts *sign1,
+                                    const uint8_t *point, size_t point_len)
+{
+    static const uint8_t context[] = {0x6a, 'S', 'i', 'g', 'n', 'a', 't', 'u', 'r', 'e', '1'};
+    static const uint8_t array_head = 0x84, empty_aad = 0x40;
+    mbedtls_sha512_context sha_ctx;
+    const mbedtls_ecp_point *q;
+    uint8_t hash[PAL_SHA384_SIZE], head[9];
+    mbedtls_mpi r, s;
+    int rc;
+
+    if (sign1->signature_len != 2U * PAL_P384_COORD_SIZE)
+        return PAL_ERROR;
+
+    q = pal_p384_key_get(point, point_len);
+    if (!q)
+        return PAL_ERROR;
+
+    /* Sig_structure = ["Signature1", protected, external_aad, payload] */
+    mbedtls_sha512_init(&sha_ctx);
+    rc = mbedtls_sha512_starts(&sha_ctx, 1);
+    rc |= mbedtls_sha512_update(&sha_ctx, &array_head, 1);
+    rc |= mbedtls_sha512_update(&sha_ctx, context, sizeof(context));
+    rc |= mbedtls_sha512_update(&sha_ctx, head, pal_cbor_put_head(head, PAL_CBOR_BSTR,
+                                                 sign1->protected_len));
+    rc |= mbedtls_sha512_update(&sha_ctx, sign1->protected_hdr, sign1->protected_len);
+    rc |= mbedtls_sha512_update(&sha_ctx, &empty_aad, 1);
+    rc |= mbedtls_sha512_update(&sha_ctx, head, pal_cbor_put_head(head, PAL_CBOR_BSTR,
+                                                 sign1->payload_len));
+    rc |= mbedtls_sha512_update(&sha_ctx, sign1->payload, sign1->payload_len);
+    rc |= mbedtls_sha512_finish(&sha_ctx, hash);
+    mbedtls_sha512_free(&sha_ctx);
+    if (rc)
+        return PAL_ERROR;
+
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    rc = mbedtls_mpi_read_binary(&r, sign1->signature, PAL_P384_COORD_SIZE);
+    rc |= mbedtls_mpi_read_binary(&s, sign1->signature + PAL_P384_COORD_SIZE,
+                                  PAL_P384_COORD_SIZE);
+    if (!rc)
+        rc = mbedtls_ecdsa_verify(&pal_p384_grp, hash, sizeof(hash), q, &r, &s);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+
+    return rc ? PAL_ERROR : PAL_SUCCESS;
+}
@@ -12,6 +12,22 @@ void *memset(void *dst, int val, size_t count);
 int memcmp(void *s1, void *s2, size_t len);
 void *memmove(void *dst, const void *src, size_t len);
 
+void *pal_memcpy_mops(void *dst, const void *src, size_t len);
+void *pal_memmove_mops(void *dst, const void *src, size_t len);
+void *pal_memset_mops(void *dst, int val, size_t count);
+
+/* Doubleword that may alias any other type, for the word at a time loops */
+typedef uint64_t __attribute__((__may_alias__)) pal_word_t;
+
+#define PAL_WORD_ALIGN_MASK     (sizeof(pal_word_t) - 1)
+#define PAL_WORD_ONES           0x0101010101010101ULL
+#define PAL_WORD_HAS_ZERO(w)    ((((w) - PAL_WORD_ONES) & ~(w) & 0x8080808080808080ULL) != 0)
+
+#define PAL_MOPS_PRESENT        1U
+#define PAL_MOPS_ABSENT         2U
+/* pal_arch.h leaves SCTLR_M_BIT to val_arch.h */
+#define PAL_SCTLR_M_BIT         ULL(1)
+
 int pal_memcmp(void *src, void *dest, size_t len)
 {
   return memcmp(src, dest, len);
@@ -28,25 +44,133 @@ void *pal_memset(void *dst, int val, size_t count)
   return dst;
 }
 
+void *pal_memzero(void *dst, size_t count)
+{
+  static uint64_t zva_size;
+  uint64_t start = (uint64_t)dst;
+  uint64_t end = start + count;
+  uint64_t zva_start, zva_end;
+
+  /* DCZID_EL0 is fixed for the PE, read it once. UINT64_MAX means DC ZVA is prohibited */
+  if (zva_size == 0)
+  {
+    uint64_t dczid = read_dczid_el0();
+
+    zva_size = (dczid & DCZID_DZP_BIT) ? UINT64_MAX :
+               (4ULL << ((dczid >> DCZID_BS_SHIFT) & DCZID_BS_MASK));
+  }
+
+  if (zva_size == UINT64_MAX || count < zva_size)
+    return pal_memset(dst, 0, count);
+
+  zva_start = (start + zva_size - 1) & ~(zva_size - 1);
+  zva_end = end & ~(zva_size - 1);
+
+  memset(dst, 0, (size_t)(zva_start - start));
+
+  for (uint64_t addr = zva_start; addr < zva_end; addr += zva_size)
+    dczva(addr);
+
+  memset((void *)zva_end, 0, (size_t)(end - zva_end));
+
+  return dst;
+}
+
 size_t pal_strlen(char *str)
 {
-  size_t length = 0;
+  const char *p = str;
+  const pal_word_t *w;
+
+  while (((uintptr_t)p & PAL_WORD_ALIGN_MASK) != 0)
+  {
+    if (*p == '\0')
+      return (size_t)(p - str);
+    ++p;
+  }
+
+  /* An aligned doubleword never crosses a page, so reading past the end is safe */
+  w = (const pal_word_t *)(uintptr_t)p;
+  while (!PAL_WORD_HAS_ZERO(*w))
+  {
+    ++w;
+  }
 
-  while (str[length] != '\0')
+  p = (const char *)(uintptr_t)w;
+  while (*p != '\0')
   {
-    ++length;
+    ++p;
   }
 
-  return length;
+  return (size_t)(p - str);
 }
 
-/* Libc functions definition */
+/*
+ * FEAT_MOPS is only used at EL2 with the stage 1 MMU on: EL1 needs HCRX_EL2.MSCEn,
+ * and with the MMU off every access is to Device memory where alignment faults.
+ */
+static bool pal_mops_usable(size_t len)
+{
+  static uint32_t mops_state;
 
-void *memcpy(void *dst, const void *src, size_t len)
+  if (len < PAL_MOPS_MIN_LEN)
+    return false;
+
+  if (mops_state == 0)
+  {
+    mops_state = ((get_current_el() == MODE_EL2) &&
+                  (((read_id_aa64isar2_el1() >> ID_AA64ISAR2_MOPS_SHIFT) &
+                   ID_AA64ISAR2_MOPS_MASK) != 0)) ? PAL_MOPS_PRESENT : PAL_MOPS_ABSENT;
+  }
+
+  return (mops_state == PAL_MOPS_PRESENT) && ((read_sctlr_el2() & PAL_SCTLR_M_BIT) != 0);
+}
+
+/*
+ * Forward copy by doublewords when both buffers share the same alignment, two
+ * doublewords per iteration so the compiler emits LDP/STP. Each pair is read
+ * before it is written, which keeps the copy correct for dst below src.
+ */
+static void *pal_copy_fwd(void *dst, const void *src, size_t len)
 {
     const char *s = src;
     char *d = dst;
 
+    if ((((uintptr_t)d ^ (uintptr_t)s) & PAL_WORD_ALIGN_MASK) == 0)
+    {
+        const pal_word_t *ws;
+        pal_word_t *wd;
+
+        while ((len != 0) && (((uintptr_t)d & PAL_WORD_ALIGN_MASK) != 0))
+        {
+            *d++ = *s++;
+            len--;
+        }
+
+        ws = (const pal_word_t *)(uintptr_t)s;
+        wd = (pal_word_t *)(uintptr_t)d;
+
+        while (len >= (2 * sizeof(pal_word_t)))
+        {
+            pal_word_t w0 = ws[0];
+            pal_word_t w1 = ws[1];
+
+            wd[0] = w0;
+            wd[1] = w1;
+            ws += 2;
+            wd += 2;
+            len -= 2 * sizeof(pal_word_t);
+        }
+
+        if (len >= sizeof(pal_word_t))
+        {
+            *wd++ = *ws++;
+            len -= sizeof(pal_word_t);
+        }
+
+        s = (const char *)(uintptr_t)ws;
+        d = (char *)(uintptr_t)wd;
+    }
+
     while (len--)
     {
         *d++ = *s++;
@@ -55,9 +179,43 @@ void *memcpy(void *dst, const void *src, size_t len)
     return dst;
 }
 
+/* Libc functions definition */
+
+void *memcpy(void *dst, const void *src, size_t len)
+{
+    if (pal_mops_usable(len))
+        return pal_memcpy_mops(dst, src, len);
+
+    return pal_copy_fwd(dst, src, len);
+}
+
 void *memset(void *dst, int val, size_t count)
 {
     unsigned char *ptr = dst;
+    pal_word_t *w;
+    pal_word_t pattern;
+
+    if (pal_mops_usable(count))
+        return pal_memset_mops(dst, val, count);
+
+    while ((count != 0) && (((uintptr_t)ptr & PAL_WORD_ALIGN_MASK) != 0))
+    {
+        *ptr++ = (unsigned char)val;
+        count--;
+    }
+
+    pattern = PAL_WORD_ONES * (unsigned char)val;
+    w = (pal_word_t *)(uintptr_t)ptr;
+
+    while (count >= (2 * sizeof(pal_word_t)))
+    {
+        w[0] = pattern;
+        w[1] = pattern;
+        w += 2;
+        count -= 2 * sizeof(pal_word_t);
+    }
+
+    ptr = (unsigned char *)(uintptr_t)w;
 
     while (count--)
     {
@@ -74,6 +232,35 @@ int memcmp(void *s1, void *s2, size_t len)
     unsigned char sc;
     unsigned char dc;
 
+    /* Skip the equal doublewords, the first mismatching one is compared bytewise */
+    if ((((uintptr_t)s ^ (uintptr_t)d) & PAL_WORD_ALIGN_MASK) == 0)
+    {
+        const pal_word_t *ws;
+        const pal_word_t *wd;
+
+        while ((len != 0) && (((uintptr_t)s & PAL_WORD_ALIGN_MASK) != 0))
+        {
+            sc = *s++;
+            dc = *d++;
+            if (sc - dc)
+                return (sc - dc);
+            len--;
+        }
+
+        ws = (const pal_word_t *)(uintptr_t)s;
+        wd = (const pal_word_t *)(uintptr_t)d;
+
+        while ((len >= sizeof(pal_word_t)) && (*ws == *wd))
+        {
+            ws++;
+            wd++;
+            len -= sizeof(pal_word_t);
+        }
+
+        s = (unsigned char *)(uintptr_t)ws;
+        d = (unsigned char *)(uintptr_t)wd;
+    }
+
     while (len--)
     {
         sc = *s++;
@@ -87,9 +274,12 @@ int memcmp(void *s1, void *s2, size_t len)
 
 void *memmove(void *dst, const void *src, size_t len)
 {
+        if (pal_mops_usable(len))
+                return pal_memmove_mops(dst, src, len);
+
         if ((size_t)dst - (size_t)src >= len) {
-                /* destination not in source data, so can safely use memcpy */
-                return memcpy(dst, src, len);
+                /* destination not in source data, so can safely copy forwards */
+                return pal_copy_fwd(dst, src, len);
         } else {
                 /* copy backwards... */
                 const char *end = dst;
@@ -39,6 +39,9 @@ PCIE_INFO_TABLE platform_pcie_cfg = {
      */
 };
 
+/* Per-bus ECAM map built from platform_pcie_cfg */
+static PCIE_CFG_MAP g_pcie_cfg_map;
+
 PCIE_READ_TABLE platform_pcie_device_hierarchy = {
     .num_entries             = PLATFORM_PCIE_NUM_ENTRIES,
     .device[0] = {PLATFORM_PCIE_DEV0_CLASSCODE,
@@ -91,6 +94,7 @@ void pal_pcie_create_info_table(PCIE_INFO_TABLE *PcieTable)
 {
 
     uint32_t i = 0;
+    uint32_t bus;
 
     if (PcieTable == NULL) {
       pal_printf("ERROR: Input PCIe Table Pointer is NULL. Cannot create PCIe INFO\n", 0, 0);
@@ -104,6 +108,8 @@ void pal_pcie_create_info_table(PCIE_INFO_TABLE *PcieTable)
         return;
     }
 
+    pal_mem_set(&g_pcie_cfg_map, sizeof(g_pcie_cfg_map), 0);
+
     for (i = 0; i < platform_pcie_cfg.num_entries; i++)
     {
         PcieTable->block[i].ecam_base      = platform_pcie_cfg.block[i].ecam_base;
@@ -111,10 +117,29 @@ void pal_pcie_create_info_table(PCIE_INFO_TABLE *PcieTable)
         PcieTable->block[i].start_bus_num  = platform_pcie_cfg.block[i].start_bus_num;
         PcieTable->block[i].end_bus_num    = platform_pcie_cfg.block[i].end_bus_num;
         PcieTable->num_entries++;
+
+        for (bus = platform_pcie_cfg.block[i].start_bus_num;
+             (bus <= platform_pcie_cfg.block[i].end_bus_num) && (bus < PCIE_MAX_BUS); bus++)
+        {
+            if (g_pcie_cfg_map.ecam_base[bus] != 0)
+                continue;
+            g_pcie_cfg_map.ecam_base[bus] = platform_pcie_cfg.block[i].ecam_base;
+            g_pcie_cfg_map.segment[bus] = (uint8_t)platform_pcie_cfg.block[i].segment_num;
+        }
     }
     return;
 }
 
+/**
+  @brief  Returns the per-bus ECAM map filled by pal_pcie_create_info_table
+
+  @return Pointer to the ECAM map
+**/
+PCIE_CFG_MAP *pal_pcie_get_cfg_map(void)
+{
+    return &g_pcie_cfg_map;
+}
+
 /**
   @brief  Returns the ECAM address of the input PCIe bridge function
 
@@ -137,6 +162,11 @@ uint64_t pal_pcie_ecam_base(uint32_t seg, uint32_t bus, uint32_t dev, uint32_t f
     ecam_index = 0;
     ecam_base = 0;
 
+    /* Buses of the first ECAM block of a segment are resolved from the map */
+    if ((bus < PCIE_MAX_BUS) && (g_pcie_cfg_map.ecam_base[bus] != 0) &&
+        (g_pcie_cfg_map.segment[bus] == seg))
+        return g_pcie_cfg_map.ecam_base[bus];
+
 
     while (ecam_index < platform_pcie_cfg.num_entries)
     {
@@ -169,7 +199,6 @@ uint32_t pal_pcie_read_cfg(uint32_t seg, uint32_t bus, uint32_t dev, uint32_t fu
     uint32_t cfg_addr;
     uint64_t ecam_base = pal_pcie_ecam_base(seg, bus, dev, func);
 
-    ecam_base = pal_pcie_ecam_base(seg, bus, dev, func);
     cfg_addr = (bus * PCIE_MAX_DEV * PCIE_MAX_FUNC * 4096) + \
                 (dev * PCIE_MAX_FUNC * 4096) + (func * 4096);
 
@@ -39,6 +39,91 @@ uint32_t g_bar32_p_max;
 uint32_t g_np_bar_size = 0, g_p_bar_size = 0;
 uint32_t g_np_bus = 0, g_p_bus = 0;
 
+/* Device table built while enumerating and the entry currently being programmed */
+static PCIE_DEV_TABLE g_pcie_dev_table;
+static PCIE_DEV_ENTRY *g_cur_dev_entry;
+
+/**
+  @brief   This API records a discovered function in the device table.
+  @param   bus,dev,func - Bus(8-bits), device(8-bits) & function(8-bits)
+  @param   id           - Device ID and Vendor ID register value
+  @param   class_code   - Class code and Revision ID register value
+  @param   header_value - Header type register value
+  @return  Pointer to the recorded entry, NULL if the table is full
+**/
+static PCIE_DEV_ENTRY *pal_pcie_dev_table_add(uint32_t bus, uint32_t dev, uint32_t func,
+                                              uint32_t id, uint32_t class_code,
+                                              uint32_t header_value)
+{
+    PCIE_DEV_ENTRY *entry;
+    uint32_t seg = g_pcie_info_table->block[pcie_index].segment_num;
+
+    if (g_pcie_dev_table.num_entries >= PCIE_DEV_TABLE_MAX_ENTRIES)
+    {
+        pal_printf("\n PCIe device table full, bdf 0x%x not recorded",
+                    PCIE_CREATE_BDF(seg, bus, dev, func), 0);
+        return NULL;
+    }
+
+    entry = &g_pcie_dev_table.device[g_pcie_dev_table.num_entries++];
+    pal_mem_set(entry, sizeof(PCIE_DEV_ENTRY), 0);
+    entry->bdf = PCIE_CREATE_BDF(seg, bus, dev, func);
+    entry->id = id;
+    entry->class_code = class_code;
+    entry->header_type = PCIE_HEADER_TYPE(header_value);
+
+    return entry;
+}
+
+/**
+  @brief   This API records the programmed base and size of a BAR for the
+           function currently being enumerated.
+  @param   offset - Config space offset of the BAR register
+  @param   base   - Programmed BAR base address
+  @param   size   - BAR size
+  @return  None
+**/
+static void pal_pcie_dev_table_set_bar(uint32_t offset, uint64_t base, uint64_t size)
+{
+    uint32_t bar_index = (offset - BAR0_OFFSET) / 4;
+
+    if ((g_cur_dev_entry == NULL) || (bar_index >= PCIE_DEV_MAX_BARS))
+        return;
+
+    g_cur_dev_entry->bar_base[bar_index] = base;
+    g_cur_dev_entry->bar_size[bar_index] = size;
+}
+
+/**
+  @brief   This API sorts the device table indices by BDF and by class code
+           so that lookups can use a binary search.
+  @param   None
+  @return  None
+**/
+static void pal_pcie_dev_table_sort(void)
+{
+    PCIE_DEV_ENTRY *dev = g_pcie_dev_table.device;
+    uint16_t *bdf_index = g_pcie_dev_table.bdf_index;
+    uint16_t *class_index = g_pcie_dev_table.class_index;
+    uint32_t i, j;
+    uint16_t key;
+
+    for (i = 0; i < g_pcie_dev_table.num_entries; i++)
+    {
+        /* Insert into the BDF ordered index */
+        key = (uint16_t)i;
+        for (j = i; (j > 0) && (dev[bdf_index[j - 1]].bdf > dev[key].bdf); j--)
+            bdf_index[j] = bdf_index[j - 1];
+        bdf_index[j] = key;
+
+        /* Insert into the (class code, BDF) ordered index */
+        for (j = i; (j > 0) && (PCIE_DEV_CLASS_KEY(&dev[class_index[j - 1]]) >
+                                PCIE_DEV_CLASS_KEY(&dev[key])); j--)
+            class_index[j] = class_index[j - 1];
+        class_index[j] = key;
+    }
+}
+
 /**
   @brief   This API reads 32-bit data from PCIe config space pointed by Bus,
            Device, Function and register offset.
@@ -216,6 +301,7 @@ pal_pcie_rp_program_bar(uint32_t bus, uint32_t dev, uint32_t func)
             }
             pal_pci_cfg_write(bus, dev, func, offset, (uint32_t)g_rp_bar64_value);
             pal_pci_cfg_write(bus, dev, func, offset + 4, (uint32_t)(g_rp_bar64_value >> 32));
+            pal_pcie_dev_table_set_bar(offset, g_rp_bar64_value, bar_size);
             offset = offset + 8;
         }
 
@@ -236,6 +322,7 @@ pal_pcie_rp_program_bar(uint32_t bus, uint32_t dev, uint32_t func)
                 continue;
             }
             pal_pci_cfg_write(bus, dev, func, offset, g_rp_bar32_value);
+            pal_pcie_dev_table_set_bar(offset, g_rp_bar32_value, bar_size);
             g_rp_bar32_value = g_rp_bar32_value + (uint32_t)bar_size;
             offset = offset + 4;
         }
@@ -307,6 +394,7 @@ void pal_pcie_program_bar_reg(uint32_t bus, uint32_t dev, uint32_t func)
 
               pal_pci_cfg_write(bus, dev, func, offset, (uint32_t)g_bar64_p_start);
               pal_pci_cfg_write(bus, dev, func, offset + 4, (uint32_t)(g_bar64_p_start >> 32));
+              pal_pcie_dev_table_set_bar(offset, g_bar64_p_start, bar_size);
 
               p_bar64_size = (uint32_t)bar_size;
               g_bar64_size = (uint32_t)bar_size;
@@ -352,6 +440,7 @@ void pal_pcie_program_bar_reg(uint32_t bus, uint32_t dev, uint32_t func)
                   g_bar32_p_start = g_bar32_p_start + p_bar_size;
 
               pal_pci_cfg_write(bus, dev, func, offset, g_bar32_p_start);
+              pal_pcie_dev_table_set_bar(offset, g_bar32_p_start, bar_size);
               p_bar_size = (uint32_t)bar_size;
               g_p_bar_size = (uint32_t)bar_size;
               g_p_bus = bus;
@@ -399,6 +488,7 @@ void pal_pcie_program_bar_reg(uint32_t bus, uint32_t dev, uint32_t func)
               g_bar32_np_start = g_bar32_np_start + np_bar_size;
 
           pal_pci_cfg_write(bus, dev, func, offset, g_bar32_np_start);
+          pal_pcie_dev_table_set_bar(offset, g_bar32_np_start, bar_size);
           np_bar_size = (uint32_t)bar_size;
           g_np_bar_size = (uint32_t)bar_size;
           g_np_bus = bus;
@@ -420,7 +510,9 @@ void pal_pcie_program_bar_reg(uint32_t bus, uint32_t dev, uint32_t func)
 }
 
 /**
-  @brief   This API performs the PCIe bus enumeration
+  @brief   This API performs the PCIe bus enumeration. Every discovered function
+           is recorded in the device table and the primary bus number of each
+           Type1 Header is cleared once its subordinate buses are enumerated.
   @param   bus,sec_bus - Bus(8-bits), secondary bus (8-bits)
   @return  sub_bus - Subordinate bus
 **/
@@ -432,10 +524,12 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
     uint32_t sub_bus = bus;
     uint32_t dev;
     uint32_t func;
+    uint32_t max_func;
     uint32_t class_code;
     uint32_t com_reg_value;
     uint32_t bar32_p_limit;
     uint32_t bar32_np_limit;
+    PCIE_DEV_ENTRY *entry;
 
     if (bus == ((g_pcie_info_table->block[pcie_index].end_bus_num) + 1))
         return sub_bus;
@@ -446,20 +540,33 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
 
     for (dev = 0; dev < PCIE_MAX_DEV; dev++)
     {
-      for (func = 0; func < PCIE_MAX_FUNC; func++)
+      max_func = PCIE_MAX_FUNC;
+      for (func = 0; func < max_func; func++)
       {
           pal_pci_cfg_read(bus, dev, func, 0, &vendor_id);
 
           if ((vendor_id == 0x0) || (vendor_id == 0xFFFFFFFF))
-                  continue;
+          {
+              /* Function 0 is mandatory, no other function exists without it */
+              if (func == 0)
+                  break;
+              continue;
+          }
 
-          /*Skip Hostbridge configuration*/
           pal_pci_cfg_read(bus, dev, func, TYPE01_RIDR, &class_code);
+          pal_pci_cfg_read(bus, dev, func, HEADER_OFFSET, &header_value);
+
+          /* Only multi-function devices implement functions other than 0 */
+          if ((func == 0) && !PCIE_MULTI_FUNC(header_value))
+              max_func = 1;
+
+          entry = pal_pcie_dev_table_add(bus, dev, func, vendor_id, class_code, header_value);
+
+          /*Skip Hostbridge configuration*/
           if ((((class_code >> CC_BASE_SHIFT) & CC_BASE_MASK) == HB_BASE_CLASS) &&
               (((class_code >> CC_SUB_SHIFT) & CC_SUB_MASK)) == HB_SUB_CLASS)
                   continue;
 
-          pal_pci_cfg_read(bus, dev, func, HEADER_OFFSET, &header_value);
           if (PCIE_HEADER_TYPE(header_value) == TYPE1_HEADER)
           {
               /* Enable memory access, Bus master enable and I/O access*/
@@ -472,8 +579,13 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
                                 ((g_bar32_np_start >> 16) & 0xFFF0));
               pal_pci_cfg_write(bus, dev, func, PRE_FET_OFFSET, ((g_bar32_p_start >> 16) & 0xFFF0));
               sub_bus = pal_pcie_enumerate_device(sec_bus, (sec_bus+1));
+
+              /* Subordinate buses are enumerated, so the primary bus number can be
+               * cleared along with the final bus range. This keeps the hardware
+               * compatible with Linux enumeration.
+               */
               pal_pci_cfg_write(bus, dev, func, BUS_NUM_REG_OFFSET,
-                                BUS_NUM_REG_CFG(sub_bus, sec_bus, bus));
+                                BUS_NUM_REG_CFG(sub_bus, sec_bus, bus) & PRI_BUS_CLEAR_MASK);
               sec_bus = sub_bus + 1;
 
               /*Obtain the start memory base address & the final memory base address of 32 bit BAR*/
@@ -486,7 +598,9 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
               get_resource_base_64(bus, dev, func, bar64_p_base, g_bar64_p_max);
 
               /* Update the BAR values of Type 1 Devices */
+              g_cur_dev_entry = entry;
               pal_pcie_rp_program_bar(bus, dev, func);
+              g_cur_dev_entry = NULL;
 
               /*Update the base and limit values*/
               bar32_p_base = g_bar32_p_start;
@@ -496,7 +610,9 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
 
           if (PCIE_HEADER_TYPE(header_value) == TYPE0_HEADER)
           {
+              g_cur_dev_entry = entry;
               pal_pcie_program_bar_reg(bus, dev, func);
+              g_cur_dev_entry = NULL;
               sub_bus = sec_bus - 1;
           }
         }
@@ -505,45 +621,6 @@ uint32_t pal_pcie_enumerate_device(uint32_t bus, uint32_t sec_bus)
     return sub_bus;
 }
 
-/**
-    @brief   This API clears the primary bus number configured in the
-             Type1 Header.
-             Note: This is done to make sure the hardware is compatible
-                   with Linux enumeration.
-    @param:  None
-    @return: None
-**/
-void pal_clear_pri_bus(void)
-{
-    uint32_t bus;
-    uint32_t dev;
-    uint32_t func;
-    uint32_t bus_value;
-    uint32_t header_value;
-    uint32_t vendor_id;
-
-    for (bus = 0; bus <= g_pcie_info_table->block[pcie_index].end_bus_num; bus++)
-    {
-        for (dev = 0; dev < PCIE_MAX_DEV; dev++)
-        {
-            for (func = 0; func < PCIE_MAX_FUNC; func++)
-            {
-                pal_pci_cfg_read(bus, dev, func, 0, &vendor_id);
-                if ((vendor_id == 0x0) || (vendor_id == 0xFFFFFFFF))
-                        continue;
-
-                pal_pci_cfg_read(bus, dev, func, HEADER_OFFSET, &header_value);
-                if (PCIE_HEADER_TYPE(header_value) == TYPE1_HEADER)
-                {
-                    pal_pci_cfg_read(bus, dev, func, BUS_NUM_REG_OFFSET, &bus_value);
-                    bus_value = bus_value & PRI_BUS_CLEAR_MASK;
-                    pal_pci_cfg_write(bus, dev, func, BUS_NUM_REG_OFFSET, bus_value);
-                }
-            }
-         }
-     }
-}
-
 void pal_pcie_enumerate(void)
 {
 
@@ -555,6 +632,7 @@ void pal_pcie_enumerate(void)
     }
 
     pal_printf("\nStarting Enumeration\n", 0, 0);
+    g_pcie_dev_table.num_entries = 0;
     while (pcie_index < g_pcie_info_table->num_entries)
     {
 
@@ -562,13 +640,61 @@ void pal_pcie_enumerate(void)
 
        sec_bus = pri_bus + 1;
        pal_pcie_enumerate_device(pri_bus, sec_bus);
-       pal_clear_pri_bus();
        pcie_index++;
     }
+    pal_pcie_dev_table_sort();
+    enumerate = 0;
+    pcie_index = 0;
+}
+
+/**
+    @brief   Completes enumeration for a device table whose entries were restored
+             from a previous boot, the devices are already programmed.
+    @param   None
+    @return  None
+**/
+void pal_pcie_enumerate_restore(void)
+{
+    pal_pcie_dev_table_sort();
     enumerate = 0;
     pcie_index = 0;
 }
 
+/**
+    @brief   Returns the device table filled during enumeration
+    @param   None
+    @return  Pointer to the device table
+**/
+PCIE_DEV_TABLE *pal_pcie_get_dev_table(void)
+{
+    return &g_pcie_dev_table;
+}
+
+/**
+    @brief   Looks up a function in the device table
+    @param   bdf - Segment/Bus/Dev/Func in the format of PCIE_CREATE_BDF
+    @return  Pointer to the device table entry, NULL if the function was not enumerated
+**/
+PCIE_DEV_ENTRY *pal_pcie_find_dev(uint32_t bdf)
+{
+    uint32_t low = 0, high = g_pcie_dev_table.num_entries, mid;
+    PCIE_DEV_ENTRY *entry;
+
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+        entry = &g_pcie_dev_table.device[g_pcie_dev_table.bdf_index[mid]];
+        if (entry->bdf == bdf)
+            return entry;
+        if (entry->bdf < bdf)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return NULL;
+}
+
 /**
     @brief   Returns the Bus, Dev, Function (in the form seg<<24 | bus<<16 | Dev <<8 | func)
              for a matching class code.
@@ -577,39 +703,41 @@ void pal_pcie_enumerate(void)
                           is not 0 : start enumeration from the input segment, bus, dev
                           this is needed as multiple controllers with same class code are
                           potentially present in a system.
+             The lookup is a binary search of the class index of the device table.
     @return  the BDF of the device matching the class code
 **/
 uint32_t
 pal_pcie_get_bdf(uint32_t ClassCode, uint32_t StartBdf)
 {
 
-    uint32_t  Bus, InputBus, Seg = 0;
-    uint32_t  Dev, InputDev;
-    uint32_t  Func, InputFunc;
-    uint32_t class_code;
-    InputBus  = PCIE_EXTRACT_BDF_BUS(StartBdf);
-    InputDev  = PCIE_EXTRACT_BDF_DEV(StartBdf);
-    InputFunc = PCIE_EXTRACT_BDF_FUNC(StartBdf);
+    uint32_t low = 0, high = g_pcie_dev_table.num_entries, mid;
+    uint64_t key, start_key;
+    PCIE_DEV_ENTRY *entry;
 
-    for (Bus = InputBus; Bus < PLATFORM_OVERRIDE_PCIE_MAX_BUS; Bus++)
+    /* Find the first entry of the class index at or above (class code, StartBdf) */
+    start_key = ((uint64_t)(ClassCode >> 8) << 32) | StartBdf;
+    while (low < high)
     {
-      for (Dev = InputDev; Dev < PCIE_MAX_DEV; Dev++)
-      {
-        for (Func = InputFunc; Func < PCIE_MAX_FUNC; Func++)
-        {
-          pal_pci_cfg_read(Bus, Dev, Func, TYPE01_RIDR, &class_code);
-          if ((class_code >> CC_BASE_SHIFT) == (ClassCode >> 16))
-          {
-            if ((class_code >> CC_SUB_SHIFT) == (ClassCode >> 8))
-            {
-            // Found our device
-            // Return the BDF*/
-              return (uint32_t)(PCIE_CREATE_BDF(Seg, Bus, Dev, Func));
-            }
-          }
-        }
-      }
+        mid = low + (high - low) / 2;
+        entry = &g_pcie_dev_table.device[g_pcie_dev_table.class_index[mid]];
+        key = PCIE_DEV_CLASS_KEY(entry);
+        if (key < start_key)
+            low = mid + 1;
+        else
+            high = mid;
     }
+
+    if (low == g_pcie_dev_table.num_entries)
+        return 0;
+
+    entry = &g_pcie_dev_table.device[g_pcie_dev_table.class_index[low]];
+    if ((entry->class_code >> CC_SUB_SHIFT) == (ClassCode >> 8))
+    {
+        // Found our device
+        // Return the BDF*/
+        return entry->bdf;
+    }
+
     return 0;
 }
 
@@ -699,11 +827,17 @@ void *pal_pci_bdf_to_dev(uint32_t bdf)
     uint32_t dev;
     uint32_t func;
 
+    PCIE_DEV_ENTRY *entry;
+
     bus  = PCIE_EXTRACT_BDF_BUS(bdf);
     dev  = PCIE_EXTRACT_BDF_DEV(bdf);
     func = PCIE_EXTRACT_BDF_FUNC(bdf);
 
-    pal_pci_cfg_read(bus, dev, func, 0, &g_vendor_id);
+    entry = pal_pcie_find_dev(bdf);
+    if (entry != NULL)
+        g_vendor_id = entry->id;
+    else
+        pal_pci_cfg_read(bus, dev, func, 0, &g_vendor_id);
     g_vendor_id = g_vendor_id >> DEVICE_ID_OFFSET;
     device_id = &g_vendor_id;
 
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * SHA-256/SHA-512 block functions for mbedtls (MBEDTLS_SHA256_PROCESS_ALT and
+ * MBEDTLS_SHA512_PROCESS_ALT). The crypto extension implementation in
+ * pal_sha2_ce.S is used when ID_AA64ISAR0_EL1 reports it, else the portable
+ * C code below.
+ */
+
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include "pal_crypto.h"
+#include "pal_arch_helpers.h"
+#include "pal_libc.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+
+#define PAL_SHA2_BACKEND_UNKNOWN    0xFFFFFFFFU
+
+#define PAL_ROR32(x, n)     (((x) >> (n)) | ((x) << (32U - (n))))
+#define PAL_ROR64(x, n)     (((x) >> (n)) | ((x) << (64U - (n))))
+
+static uint32_t pal_sha2_backend = PAL_SHA2_BACKEND_UNKNOWN;
+
+/* Round constants, also loaded by pal_sha2_ce.S */
+const uint32_t pal_sha256_k[64] = {
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U,
+    0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+    0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U,
+    0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+    0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU,
+    0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+    0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U,
+    0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+    0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U,
+    0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+    0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U,
+    0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+    0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U,
+    0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U,
+    0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+const uint64_t pal_sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL,
+    0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+    0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL,
+    0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL,
+    0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+    0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL,
+    0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL,
+    0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+    0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL,
+    0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL,
+    0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+    0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL,
+    0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL,
+    0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+    0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL,
+    0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL,
+    0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+    0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL,
+    0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL,
+    0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+    0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+/**
+  @brief  Stop FP/SIMD accesses at the current EL from trapping, the crypto
+          extension instructions operate on the SIMD registers. The trap
+          controls are per PE and, in a realm, per REC, so the state is
+          checked on every call rather than cached.
+  @return None
+**/
+static void pal_sha2_simd_enable(void)
+{
+    uint64_t reg;
+
+    if (IS_IN_EL2())
+    {
+        reg = read_cptr_el2();
+        if ((reg & CPTR_EL2_TFP_BIT) == 0U)
+            return;
+        write_cptr_el2(reg & ~CPTR_EL2_TFP_BIT);
+    }
+    else if (IS_IN_EL1())
+    {
+        reg = read_cpacr_el1();
+        if ((reg & CPACR_EL1_FPEN(CPACR_EL1_FP_TRAP_NONE)) ==
+                                CPACR_EL1_FPEN(CPACR_EL1_FP_TRAP_NONE))
+            return;
+        write_cpacr_el1(reg | CPACR_EL1_FPEN(CPACR_EL1_FP_TRAP_NONE));
+    }
+    else
+        return;
+
+    isb();
+}
+
+/**
+  @brief  Select the SHA-2 block backend on first use. The result only
+          depends on the ID registers; the FP/SIMD trap state is handled
+          by each block hook before it enters the crypto extension path.
+  @return Returns a mask of PAL_SHA2_BACKEND_CE_* bits, PAL_SHA2_BACKEND_C if
+          the crypto extension is not implemented
+**/
+uint32_t pal_sha2_backend_get(void)
+{
+    uint64_t sha2;
+
+    if (pal_sha2_backend != PAL_SHA2_BACKEND_UNKNOWN)
+        return pal_sha2_backend;
+
+    sha2 = (read_id_aa64isar0_el1() >> ID_AA64ISAR0_EL1_SHA2_SHIFT) &
+                                                ID_AA64ISAR0_EL1_SHA2_MASK;
+    if (sha2 >= ID_AA64ISAR0_EL1_SHA2_SHA512)
+        pal_sha2_backend = PAL_SHA2_BACKEND_CE_SHA256 | PAL_SHA2_BACKEND_CE_SHA512;
+    else if (sha2 == ID_AA64ISAR0_EL1_SHA2_SHA256)
+        pal_sha2_backend = PAL_SHA2_BACKEND_CE_SHA256;
+    else
+        pal_sha2_backend = PAL_SHA2_BACKEND_C;
+
+    return pal_sha2_backend;
+}
+
+static inline uint32_t pal_load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline uint64_t pal_load_be64(const uint8_t *p)
+{
+    return ((uint64_t)pal_load_be32(p) << 32) | pal_load_be32(p + 4);
+}
+
+/**
+  @brief  Portable SHA-256 compression function
+  @param  state   - hash state a..h
+  @param  data    - input blocks
+  @param  blocks  - number of 64 byte blocks
+  @return None
+**/
+static void pal_sha256_blocks_c(uint32_t state[8], const uint8_t *data, size_t blocks)
+{
+    uint32_t w[16], v[8], t1, t2;
+    uint32_t i;
+
+    while (blocks-- != 0U)
+    {
+        for (i = 0; i < 8U; i++)
+            v[i] = state[i];
+
+        for (i = 0; i < 64U; i++)
+        {
+            if (i < 16U)
+                w[i] = pal_load_be32(data + 4U * i);
+            else
+            {
+                t1 = w[(i + 1U) & 15U];
+                t2 = w[(i + 14U) & 15U];
+                w[i & 15U] += (PAL_ROR32(t1, 7U) ^ PAL_ROR32(t1, 18U) ^ (t1 >> 3)) +
+                              (PAL_ROR32(t2, 17U) ^ PAL_ROR32(t2, 19U) ^ (t2 >> 10)) +
+                              w[(i + 9U) & 15U];
+            }
+
+            t1 = v[7] + (PAL_ROR32(v[4], 6U) ^ PAL_ROR32(v[4], 11U) ^ PAL_ROR32(v[4], 25U)) +
+                 ((v[4] & v[5]) ^ (~v[4] & v[6])) + pal_sha256_k[i] + w[i & 15U];
+            t2 = (PAL_ROR32(v[0], 2U) ^ PAL_ROR32(v[0], 13U) ^ PAL_ROR32(v[0], 22U)) +
+                 ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+            v[7] = v[6];
+            v[6] = v[5];
+            v[5] = v[4];
+            v[4] = v[3] + t1;
+            v[3] = v[2];
+            v[2] = v[1];
+            v[1] = v[0];
+            v[0] = t1 + t2;
+        }
+
+        for (i = 0; i < 8U; i++)
+            state[i] += v[i];
+        data += 64;
+    }
+}
+
+/**
+  @brief  Portable SHA-512 compression function
+  @param  state   - hash state a..h
+  @param  data    - input blocks
+  @param  blocks  - number of 128 byte blocks
+  @return None
+**/
+static void pal_sha512_blocks_c(uint64_t state[8], const uint8_t *data, size_t blocks)
+{
+    uint64_t w[16], v[8], t1, t2;
+    uint32_t i;
+
+    while (blocks-- != 0U)
+    {
+        for (i = 0; i < 8U; i++)
+            v[i] = state[i];
+
+        for (i = 0; i < 80U; i++)
+        {
+            if (i < 16U)
+                w[i] = pal_load_be64(data + 8U * i);
+            else
+            {
+                t1 = w[(i + 1U) & 15U];
+                t2 = w[(i + 14U) & 15U];
+                w[i & 15U] += (PAL_ROR64(t1, 1U) ^ PAL_ROR64(t1, 8U) ^ (t1 >> 7)) +
+                              (PAL_ROR64(t2, 19U) ^ PAL_ROR64(t2, 61U) ^ (t2 >> 6)) +
+                              w[(i + 9U) & 15U];
+            }
+
+            t1 = v[7] + (PAL_ROR64(v[4], 14U) ^ PAL_ROR64(v[4], 18U) ^ PAL_ROR64(v[4], 41U)) +
+                 ((v[4] & v[5]) ^ (~v[4] & v[6])) + pal_sha512_k[i] + w[i & 15U];
+            t2 = (PAL_ROR64(v[0], 28U) ^ PAL_ROR64(v[0], 34U) ^ PAL_ROR64(v[0], 39U)) +
+                 ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+            v[7] = v[6];
+            v[6] = v[5];
+            v[5] = v[4];
+            v[4] = v[3] + t1;
+            v[3] = v[2];
+            v[2] = v[1];
+            v[1] = v[0];
+            v[0] = t1 + t2;
+        }
+
+        for (i = 0; i < 8U; i++)
+            state[i] += v[i];
+        data += 128;
+    }
+}
+
+/**
+  @brief  mbedtls SHA-224/SHA-256 block hook
+  @param  ctx   - mbedtls SHA-256 context
+  @param  data  - one 64 byte block
+  @return Returns zero
+**/
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx, const unsigned char data[64])
+{
+    if ((pal_sha2_backend_get() & PAL_SHA2_BACKEND_CE_SHA256) != 0U)
+    {
+        pal_sha2_simd_enable();
+        pal_sha256_blocks_ce(ctx->state, data, 1);
+    }
+    else
+        pal_sha256_blocks_c(ctx->state, data, 1);
+
+    return 0;
+}
+
+/**
+  @brief  mbedtls SHA-384/SHA-512 block hook
+  @param  ctx   - mbedtls SHA-512 context
+  @param  data  - one 128 byte block
+  @return Returns zero
+**/
+int mbedtls_internal_sha512_process(mbedtls_sha512_context *ctx, const unsigned char data[128])
+{
+    if ((pal_sha2_backend_get() & PAL_SHA2_BACKEND_CE_SHA512) != 0U)
+    {
+        pal_sha2_simd_enable();
+        pal_sha512_blocks_ce(ctx->state, data, 1);
+    }
+    else
+        pal_sha512_blocks_c(ctx->state, data, 1);
+
+    return 0;
+}
+
+/**
+  @brief  Hash a buffer with the given SHA-2 algorithm through the given block
+          backend, independently of the backend picked for mbedtls. Used to
+          compare the crypto extension and portable paths against each other.
+  @param  backend - PAL_SHA2_BACKEND_C, or the PAL_SHA2_BACKEND_CE_* bit of alg
+  @param  alg     - PAL_SHA2_ALG_SHA256, PAL_SHA2_ALG_SHA384 or PAL_SHA2_ALG_SHA512
+  @param  data    - input buffer
+  @param  len     - input size in bytes
+  @param  digest  - output buffer, at least PAL_SHA2_DIGEST_SIZE(alg) bytes
+  @return Returns PAL_SUCCESS, PAL_ERROR for an unknown algorithm or a
+          backend the PE does not implement
+**/
+uint32_t pal_sha2_digest(uint32_t backend, uint32_t alg, const uint8_t *data,
+                         size_t len, uint8_t *digest)
+{
+    static const uint32_t iv256[8] = {
+        0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+        0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+    };
+    static const uint64_t iv384[8] = {
+        0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL,
+        0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+        0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL,
+        0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+    };
+    static const uint64_t iv512[8] = {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
+        0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+        0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+    };
+    uint8_t tail[256];
+    uint32_t state32[8];
+    uint64_t state64[8];
+    uint64_t bits = (uint64_t)len << 3;
+    size_t block, full, rem, tail_len, i;
+    bool sha256 = (alg == PAL_SHA2_ALG_SHA256);
+    uint32_t ce = sha256 ? PAL_SHA2_BACKEND_CE_SHA256 : PAL_SHA2_BACKEND_CE_SHA512;
+
+    if ((alg != PAL_SHA2_ALG_SHA256) && (alg != PAL_SHA2_ALG_SHA384) &&
+        (alg != PAL_SHA2_ALG_SHA512))
+        return PAL_ERROR;
+
+    if ((backend != PAL_SHA2_BACKEND_C) &&
+        ((backend != ce) || ((pal_sha2_backend_get() & ce) == 0U)))
+        return PAL_ERROR;
+
+    if (backend != PAL_SHA2_BACKEND_C)
+        pal_sha2_simd_enable();
+
+    block = sha256 ? 64U : 128U;
+    full = len / block;
+    rem = len % block;
+
+    /* Padding: 0x80, zeroes, then the message length in bits, big endian */
+    tail_len = ((rem + 1U + (sha256 ? 8U : 16U)) <= block) ? block : 2U * block;
+    pal_memset(tail, 0, tail_len);
+    pal_memcpy(tail, data + (full * block), rem);
+    tail[rem] = 0x80U;
+    for (i = 0; i < 8U; i++)
+        tail[tail_len - 1U - i] = (uint8_t)(bits >> (8U * i));
+
+    if (sha256)
+    {
+        pal_memcpy(state32, iv256, sizeof(state32));
+        if (backend != PAL_SHA2_BACKEND_C)
+        {
+            pal_sha256_blocks_ce(state32, data, full);
+            pal_sha256_blocks_ce(state32, tail, tail_len / block);
+        }
+        else
+        {
+            pal_sha256_blocks_c(state32, data, full);
+            pal_sha256_blocks_c(state32, tail, tail_len / block);
+        }
+
+        for (i = 0; i < 32U; i++)
+            digest[i] = (uint8_t)(state32[i / 4U] >> (24U - 8U * (i % 4U)));
+
+        return PAL_SUCCESS;
+    }
+
+    pal_memcpy(state64, (alg == PAL_SHA2_ALG_SHA384) ? iv384 : iv512, sizeof(state64));
+    if (backend != PAL_SHA2_BACKEND_C)
+    {
+        pal_sha512_blocks_ce(state64, data, full);
+        pal_sha512_blocks_ce(state64, tail, tail_len / block);
+    }
+    else
+    {
+        pal_sha512_blocks_c(state64, data, full);
+        pal_sha512_blocks_c(state64, tail, tail_len / block);
+    }
+
+    for (i = 0; i < PAL_SHA2_DIGEST_SIZE(alg); i++)
+        digest[i] = (uint8_t)(state64[i / 8U] >> (56U - 8U * (i % 8U)));
+
+    return PAL_SUCCESS;
+}
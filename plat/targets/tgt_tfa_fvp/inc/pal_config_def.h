@@ -52,6 +52,18 @@
 #define PLATFORM_NVM_BASE    (0x80000000+0x2800000)
 #define PLATFORM_NVM_SIZE    0x10000
 
+/* Upper half of the NVM preserves the PCIe enumeration across warm resets */
+#define PLATFORM_NVM_PCIE_TABLE_OFFSET  0x8000
+#define PLATFORM_NVM_PCIE_TABLE_SIZE    0x8000
+
+/* Per test durations, kept below the PCIe table so they also survive warm resets */
+#define PLATFORM_NVM_TEST_TIMING_OFFSET 0x4000
+#define PLATFORM_NVM_TEST_TIMING_SIZE   0x3FF0
+
+/* Runtime shard selection, preloaded by the launcher and never written by the ACS */
+#define PLATFORM_NVM_TEST_SHARD_OFFSET  0x7FF0
+#define PLATFORM_NVM_TEST_SHARD_SIZE    0x10
+
 /* Base address of watchdog assigned */
 #define PLATFORM_WDOG_BASE    0x1C0F0000 //(SP805)
 #define PLATFORM_WDOG_SIZE    0x10000
@@ -170,9 +182,6 @@
 /* Non-secure EL2 physical timer interrupt */
 #define IRQ_PHY_TIMER_EL2           26
 
-/* Need to be adjusted based on platform */
-#define ITERATIONS_PER_MS 10000
-
 #define IPA_WIDTH_DEFAULT   40
 
 #define PGT_IAS     IPA_WIDTH_DEFAULT
@@ -190,6 +199,13 @@
 /* Maximum size of Realm CCA token */
 #define MAX_REALM_CCA_TOKEN_SIZE    0x1000
 
+/*
+ * Uncompressed P-384 CPAK public key used to verify the platform token, as
+ * { 0x04, X[48], Y[48] }. Leave undefined when no key is provisioned, only the
+ * realm token signature is then verified.
+ */
+/* #define PLATFORM_CPAK_PUBLIC_KEY { 0x04, ... } */
+
 /* LFA RMM GUIDs */
 #define PLATFORM_LFA_RMM_GUID0 0x564bf212a662076c
 #define PLATFORM_LFA_RMM_GUID1 0xd90636638fbacb92
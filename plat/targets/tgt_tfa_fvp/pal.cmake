@@ -20,10 +20,13 @@ set(PAL_SRC
     ${ROOT_DIR}/plat/driver/src/pal_smmuv3_test_engine.c
     ${ROOT_DIR}/plat/common/src/pal_smc.c
     ${ROOT_DIR}/plat/common/src/pal_libc.c
+    ${ROOT_DIR}/plat/common/src/pal_mops.S
     ${ROOT_DIR}/plat/common/src/pal_pcie.c
     ${ROOT_DIR}/plat/common/src/pal_pcie_enumeration.c
     ${ROOT_DIR}/plat/common/src/pal_exerciser.c
     ${ROOT_DIR}/plat/common/src/pal_crypto.c
+    ${ROOT_DIR}/plat/common/src/pal_sha2.c
+    ${ROOT_DIR}/plat/common/src/pal_sha2_ce.S
     ${ROOT_DIR}/plat/common/src/pal_rhi.c
     ${ROOT_DIR}/plat/common/src/pal_syscall.S
     ${ROOT_DIR}/plat/common/src/pal_spinlock.S
@@ -7,6 +7,7 @@
 
 #include "pal_interfaces.h"
 #include "pal_pl011_uart.h"
+#include "pal_crypto.h"
 
 uint32_t pal_terminate_simulation(void)
 {
@@ -16,12 +17,33 @@ uint32_t pal_terminate_simulation(void)
 
 /*
  * function interface for verifying the signature of the provided token
- * @parameter toekn : token recived from the platform
- * @return : true/false
+ * The realm token is verified with the RAK carried in its cca-realm-public-key
+ * claim. The platform token is verified only when a CPAK is provisioned.
+ * @parameter platform_token : COSE_Sign1 parts of the platform token
+ * @parameter realm_token    : COSE_Sign1 parts of the realm token
+ * @parameter rak            : RAK as an uncompressed P-384 point
+ * @parameter rak_len        : size of the RAK
+ * @return : PAL_SUCCESS/PAL_ERROR
  */
 
-__attribute__((weak)) uint32_t pal_verify_signature(__attribute__ ((unused)) uint64_t *token)
+__attribute__((weak)) uint32_t pal_verify_signature(const pal_cose_sign1_ts *platform_token,
+                                                    const pal_cose_sign1_ts *realm_token,
+                                                    const uint8_t *rak, size_t rak_len)
 {
+#ifdef PLATFORM_CPAK_PUBLIC_KEY
+    static const uint8_t cpak[PAL_P384_POINT_SIZE] = PLATFORM_CPAK_PUBLIC_KEY;
+#endif
+
+    if (pal_cose_sign1_verify_p384(realm_token, rak, rak_len))
+        return PAL_ERROR;
+
+#ifdef PLATFORM_CPAK_PUBLIC_KEY
+    if (pal_cose_sign1_verify_p384(platform_token, cpak, sizeof(cpak)))
+        return PAL_ERROR;
+#else
+    (void)platform_token;
+#endif
+
     return PAL_SUCCESS;
 }
 
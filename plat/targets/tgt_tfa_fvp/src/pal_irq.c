@@ -40,6 +40,13 @@ extern uint64_t security_state;
  */
 static s_lock_t spi_lock;
 
+/*
+ * Interrupt dispatcher for the security state of this image, chosen once
+ * instead of testing security_state on every IRQ.
+ */
+static int pal_irq_dispatch_select(void);
+static int (*irq_dispatcher)(void) = pal_irq_dispatch_select;
+
 static handler_irq_t *get_irq_handler(unsigned int irq_num)
 {
     if (IS_PLAT_SPI(irq_num))
@@ -136,7 +143,11 @@ static int pal_irq_update_handler(unsigned int irq_num,
      */
     assert(HANDLER_VALID(*cur_handler, expect_handler));
     if (HANDLER_VALID(*cur_handler, expect_handler)) {
-        *cur_handler = irq_handler;
+        /*
+         * The dispatcher reads SPI handlers without taking spi_lock, so
+         * publish the new pointer with release semantics.
+         */
+        __atomic_store_n(cur_handler, irq_handler, __ATOMIC_RELEASE);
         ret = 0;
     }
 
@@ -186,57 +197,90 @@ void pal_gic_end_of_intr(unsigned int irq_num)
     }
 }
 
-int pal_irq_handler_dispatcher(void)
+/*
+ * Call the handler registered for irq_num. SGI and PPI handlers are banked per
+ * CPU and only ever updated by the CPU that owns them, SPI handlers are read
+ * lock-free and pair with the release store in pal_irq_update_handler().
+ */
+static int pal_irq_call_handler(unsigned int irq_num)
 {
-    unsigned int irq_num;
     sgi_data_t sgi_data;
-    handler_irq_t *handler;
-    void *irq_data = NULL;
-    /* Acknowledge the interrupt */
-    unsigned int raw_iar;
+    handler_irq_t handler;
+    void *irq_data = &irq_num;
 
-    if (security_state == 2)
-    {
-        irq_num = (uint32_t)read_icv_iar1_el1();
+    if (IS_PLAT_SPI(irq_num)) {
+        handler = __atomic_load_n(&spi_desc_table[irq_num - MIN_SPI_ID].handler,
+                                  __ATOMIC_ACQUIRE);
+    } else if (IS_PPI(irq_num) || IS_SGI(irq_num)) {
+        unsigned int linear_id = platform_get_core_pos(read_mpidr_el1());
+
+        if (IS_PPI(irq_num)) {
+            handler = ppi_desc_table[linear_id][irq_num - MIN_PPI_ID].handler;
+        } else {
+            handler = sgi_desc_table[linear_id][irq_num - MIN_SGI_ID].handler;
+            sgi_data.irq_id = irq_num;
+            irq_data = &sgi_data;
+        }
     } else {
-        irq_num = arm_gic_intr_ack(&raw_iar);
+        assert(irq_num == GIC_SPURIOUS_INTERRUPT);
+        handler = spurious_desc_handler;
+        irq_data = NULL;
     }
 
-    handler = get_irq_handler(irq_num);
-    if (IS_PLAT_SPI(irq_num)) {
-        irq_data = &irq_num;
-    } else if (IS_PPI(irq_num)) {
-        irq_data = &irq_num;
-    } else if (IS_SGI(irq_num)) {
-        sgi_data.irq_id = irq_num;
-        irq_data = &sgi_data;
-    }
+    if (handler == NULL)
+        return PAL_ERROR;
 
-    if (*handler != NULL) {
-        (*handler)(irq_data);
-    } else {
+    (void)handler(irq_data);
+
+    return PAL_SUCCESS;
+}
+
+/* Realm: virtual CPU interface, the handlers deactivate the interrupt */
+static int pal_irq_dispatch_virtual(void)
+{
+    return pal_irq_call_handler((uint32_t)read_icv_iar1_el1());
+}
+
+/* Host and secure: acknowledge and complete through the GIC driver */
+static int pal_irq_dispatch_gic(void)
+{
+    unsigned int raw_iar;
+    unsigned int irq_num = arm_gic_intr_ack(&raw_iar);
+
+    if (pal_irq_call_handler(irq_num) != PAL_SUCCESS)
         return PAL_ERROR;
-    }
 
-    if (security_state != 2)
-    {
-        /* Mark the processing of the interrupt as complete */
-        if (irq_num != GIC_SPURIOUS_INTERRUPT)
-            arm_gic_end_of_intr(raw_iar);
-    }
+    /* Mark the processing of the interrupt as complete */
+    if (irq_num != GIC_SPURIOUS_INTERRUPT)
+        arm_gic_end_of_intr(raw_iar);
 
     return PAL_SUCCESS;
 }
 
+static int pal_irq_dispatch_select(void)
+{
+    irq_dispatcher = (security_state == 2) ? pal_irq_dispatch_virtual :
+                                             pal_irq_dispatch_gic;
+
+    return irq_dispatcher();
+}
+
+int pal_irq_handler_dispatcher(void)
+{
+    return irq_dispatcher();
+}
+
 void pal_irq_setup(void)
 {
     if (security_state == 2)
     {
+        irq_dispatcher = pal_irq_dispatch_virtual;
         enable_irq();
         enable_fiq();
         write_icc_pmr_el1(0xff);
         write_icc_igrpen1_el1(read_icc_igrpen1_el1() | 0x1);
     } else {
+        irq_dispatcher = pal_irq_dispatch_gic;
         pal_printf("GIC Initialisation started \n", 0, 0);
         arm_gic_init(GICD_BASE, GICR_BASE);
         pal_memset(spi_desc_table, 0, sizeof(spi_desc_table));
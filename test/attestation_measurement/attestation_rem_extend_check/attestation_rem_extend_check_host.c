@@ -8,10 +8,23 @@
 #include "test_database.h"
 #include "val_host_rmi.h"
 #include "val_host_command.h"
+#include "val_host_measurement.h"
+
+/* The Realm reports RSI_MEASUREMENT_READ x1-x7 in gprs[1]-gprs[7] */
+#define REM_REPORT_SIZE     (7 * sizeof(uint64_t))
+
+/* Value the Realm extends REM[1] with */
+static const uint64_t rem_extend_value[8] = {
+    0x05a9bf223fedf80a, 0x9d0da5f73f5c191a, 0x665bf4a0a4a3e608, 0xf2f9e7d5ff23959c,
+    0, 0, 0, 0
+};
 
 void attestation_rem_extend_check_host(void)
 {
     val_host_realm_ts realm;
+    val_host_rec_exit_ts *rec_exit;
+    const val_host_meas_ts *meas;
+    size_t size;
     uint64_t ret;
 
     val_memset(&realm, 0, sizeof(realm));
@@ -33,6 +46,33 @@ void attestation_rem_extend_check_host(void)
         val_set_status(RESULT_FAIL(VAL_ERROR_POINT(6)));
         goto destroy_realm;
     }
+
+    rec_exit = &(((val_host_rec_run_ts *)realm.run[0])->exit);
+    if (val_host_check_realm_exit_host_call((val_host_rec_run_ts *)realm.run[0]) ||
+        rec_exit->gprs[0])
+    {
+        LOG(ERROR, "Realm did not report its REM\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(7)));
+        goto destroy_realm;
+    }
+
+    /* Apply the same extension to the reference model */
+    if (val_host_meas_rem_extend(realm.rd, 1, rem_extend_value, sizeof(rem_extend_value)))
+    {
+        LOG(ERROR, "Reference REM extend failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(8)));
+        goto destroy_realm;
+    }
+
+    meas = val_host_meas_get(realm.rd);
+    size = (meas->size < REM_REPORT_SIZE) ? meas->size : REM_REPORT_SIZE;
+    if (val_memcmp(&rec_exit->gprs[1], (void *)meas->rem[0], size))
+    {
+        LOG(ERROR, "REM does not match the reference model\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(9)));
+        goto destroy_realm;
+    }
+
     val_set_status(RESULT_PASS(VAL_SUCCESS));
 
 destroy_realm:
@@ -13,6 +13,7 @@
 void attestation_rem_extend_check_realm(void)
 {
     val_smc_param_ts args = {0}, zero_ref = {0};
+    __attribute__((aligned (PAGE_SIZE))) val_realm_rsi_host_call_t gv_realm_host_call = {0};
 
     val_realm_rsi_measurement_extend(1, 64, 0x05a9bf223fedf80a,
                                             0x9d0da5f73f5c191a,
@@ -35,6 +36,19 @@ void attestation_rem_extend_check_realm(void)
         goto exit;
     }
 
+    /* Report the REM to the host, which checks it against its reference model */
+    gv_realm_host_call.imm = VAL_SWITCH_TO_HOST;
+    gv_realm_host_call.gprs[0] = args.x0;
+    gv_realm_host_call.gprs[1] = args.x1;
+    gv_realm_host_call.gprs[2] = args.x2;
+    gv_realm_host_call.gprs[3] = args.x3;
+    gv_realm_host_call.gprs[4] = args.x4;
+    gv_realm_host_call.gprs[5] = args.x5;
+    gv_realm_host_call.gprs[6] = args.x6;
+    gv_realm_host_call.gprs[7] = args.x7;
+
+    val_realm_rsi_host_call_struct((uint64_t)&gv_realm_host_call);
+
 exit:
     val_realm_return_to_host();
 }
@@ -13,9 +13,8 @@
 void attestation_rpv_value_realm(void)
 {
     val_smc_param_ts args = {0,};
-    uint64_t i, token_size = 0, ret, size, max_size, len;
+    uint64_t i, token_size = 0, ret;
     __attribute__((aligned (PAGE_SIZE))) uint64_t token[MAX_REALM_CCA_TOKEN_SIZE/8] = {0,};
-    uint64_t *granule = token;
 
     uint64_t challenge[8] = {0xb4ea40d262abaf22,
                              0xe8d966127b6d78e2,
@@ -40,23 +39,8 @@ void attestation_rpv_value_realm(void)
         goto exit;
     }
 
-    max_size = args.x1;
-
-    do {
-        uint64_t offset = 0;
-        do {
-            size = PAGE_SIZE - offset;
-            args = val_realm_rsi_attestation_token_continue((uint64_t)granule, offset, size, &len);
-            offset += len;
-            token_size = token_size + len;
-        } while (args.x0 == RSI_ERROR_INCOMPLETE && offset < PAGE_SIZE);
-
-        if (args.x0 == RSI_ERROR_INCOMPLETE)
-        {
-            granule += PAGE_SIZE;
-        }
-
-    } while ((args.x0 == RSI_ERROR_INCOMPLETE) && (granule < token + max_size));
+    args.x0 = val_realm_rsi_attestation_token_fetch((uint8_t *)token, sizeof(token),
+                                                     &token_size);
 
     if (args.x0)
     {
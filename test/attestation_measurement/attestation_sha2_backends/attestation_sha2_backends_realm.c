@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "test_database.h"
+#include "val_realm_framework.h"
+#include "val_timer.h"
+#include "val_crypto.h"
+
+/* Size of the buffer hashed for the throughput and cross checks */
+#define SHA2_BENCH_SIZE         0x4000U
+/* Stop each throughput run after this many digests or a quarter second */
+#define SHA2_BENCH_MAX_ITER     256U
+
+typedef struct {
+    uint32_t alg;
+    const char *msg;
+    uint64_t len;
+    uint8_t digest[64];
+} sha2_kat_ts;
+
+/* FIPS 180-2 examples */
+static const sha2_kat_ts sha2_kat[] = {
+    {PAL_SHA2_ALG_SHA256, "abc", 3,
+     {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde,
+      0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+      0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad}},
+    {PAL_SHA2_ALG_SHA256, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56,
+     {0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93,
+      0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
+      0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1}},
+    {PAL_SHA2_ALG_SHA384, "abc", 3,
+     {0xcb, 0x00, 0x75, 0x3f, 0x45, 0xa3, 0x5e, 0x8b, 0xb5, 0xa0, 0x3d, 0x69,
+      0x9a, 0xc6, 0x50, 0x07, 0x27, 0x2c, 0x32, 0xab, 0x0e, 0xde, 0xd1, 0x63,
+      0x1a, 0x8b, 0x60, 0x5a, 0x43, 0xff, 0x5b, 0xed, 0x80, 0x86, 0x07, 0x2b,
+      0xa1, 0xe7, 0xcc, 0x23, 0x58, 0xba, 0xec, 0xa1, 0x34, 0xc8, 0x25, 0xa7}},
+    {PAL_SHA2_ALG_SHA384, "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                          "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 112,
+     {0x09, 0x33, 0x0c, 0x33, 0xf7, 0x11, 0x47, 0xe8, 0x3d, 0x19, 0x2f, 0xc7,
+      0x82, 0xcd, 0x1b, 0x47, 0x53, 0x11, 0x1b, 0x17, 0x3b, 0x3b, 0x05, 0xd2,
+      0x2f, 0xa0, 0x80, 0x86, 0xe3, 0xb0, 0xf7, 0x12, 0xfc, 0xc7, 0xc7, 0x1a,
+      0x55, 0x7e, 0x2d, 0xb9, 0x66, 0xc3, 0xe9, 0xfa, 0x91, 0x74, 0x60, 0x39}},
+    {PAL_SHA2_ALG_SHA512, "abc", 3,
+     {0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73, 0x49,
+      0xae, 0x20, 0x41, 0x31, 0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2,
+      0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a, 0x21, 0x92, 0x99, 0x2a,
+      0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+      0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e, 0x2a, 0x9a, 0xc9, 0x4f,
+      0xa5, 0x4c, 0xa4, 0x9f}},
+    {PAL_SHA2_ALG_SHA512, "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                          "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 112,
+     {0x8e, 0x95, 0x9b, 0x75, 0xda, 0xe3, 0x13, 0xda, 0x8c, 0xf4, 0xf7, 0x28,
+      0x14, 0xfc, 0x14, 0x3f, 0x8f, 0x77, 0x79, 0xc6, 0xeb, 0x9f, 0x7f, 0xa1,
+      0x72, 0x99, 0xae, 0xad, 0xb6, 0x88, 0x90, 0x18, 0x50, 0x1d, 0x28, 0x9e,
+      0x49, 0x00, 0xf7, 0xe4, 0x33, 0x1b, 0x99, 0xde, 0xc4, 0xb5, 0x43, 0x3a,
+      0xc7, 0xd3, 0x29, 0xee, 0xb6, 0xdd, 0x26, 0x54, 0x5e, 0x96, 0xe5, 0x5b,
+      0x87, 0x4b, 0xe9, 0x09}},
+};
+
+/* Lengths around the block and padding boundaries of both block sizes */
+static const uint64_t sha2_cross_len[] = {0, 1, 55, 56, 63, 64, 65, 111, 112, 127, 128,
+                                          129, 1000, SHA2_BENCH_SIZE};
+
+static const uint32_t sha2_algs[] = {PAL_SHA2_ALG_SHA256, PAL_SHA2_ALG_SHA384,
+                                     PAL_SHA2_ALG_SHA512};
+
+static uint8_t sha2_buf[SHA2_BENCH_SIZE];
+
+static uint32_t sha2_ce_bit(uint32_t alg)
+{
+    return (alg == PAL_SHA2_ALG_SHA256) ? PAL_SHA2_BACKEND_CE_SHA256 : PAL_SHA2_BACKEND_CE_SHA512;
+}
+
+static uint64_t sha2_throughput(uint32_t backend, uint32_t alg)
+{
+    uint8_t digest[64];
+    uint64_t start, elapsed = 0, count, freq = val_read_cntfrq_el0();
+
+    start = val_read_cntpct_el0();
+    for (count = 0; (count < SHA2_BENCH_MAX_ITER) && (elapsed < freq / 4); count++)
+    {
+        (void)val_sha2_digest(backend, alg, sha2_buf, SHA2_BENCH_SIZE, digest);
+        elapsed = val_read_cntpct_el0() - start;
+    }
+
+    if (elapsed == 0)
+        elapsed = 1;
+
+    /* KB/s, MB/s would round to 0 on slow models */
+    return (count * SHA2_BENCH_SIZE * freq) / (elapsed * 1024U);
+}
+
+void attestation_sha2_backends_realm(void)
+{
+    uint32_t backends = val_sha2_backend_get();
+    uint8_t digest_c[64], digest_ce[64];
+    uint32_t i, j, alg, size;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+    /* Known answers on the portable path, and on the CE path when implemented */
+    for (i = 0; i < ARRAY_SIZE(sha2_kat); i++)
+    {
+        alg = sha2_kat[i].alg;
+        size = PAL_SHA2_DIGEST_SIZE(alg);
+
+        if (val_sha2_digest(PAL_SHA2_BACKEND_C, alg, (const uint8_t *)sha2_kat[i].msg,
+                            sha2_kat[i].len, digest_c) ||
+            val_memcmp(digest_c, (void *)sha2_kat[i].digest, size))
+        {
+            LOG(ERROR, "Portable digest mismatch for vector %d\n", i);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+            goto exit;
+        }
+
+        if ((backends & sha2_ce_bit(alg)) == 0)
+            continue;
+
+        if (val_sha2_digest(sha2_ce_bit(alg), alg, (const uint8_t *)sha2_kat[i].msg,
+                            sha2_kat[i].len, digest_ce) ||
+            val_memcmp(digest_ce, (void *)sha2_kat[i].digest, size))
+        {
+            LOG(ERROR, "Crypto extension digest mismatch for vector %d\n", i);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+            goto exit;
+        }
+    }
+
+    for (i = 0; i < SHA2_BENCH_SIZE; i++)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        sha2_buf[i] = (uint8_t)(seed >> 56);
+    }
+
+    /* Both paths must agree on every padding case */
+    for (i = 0; i < ARRAY_SIZE(sha2_algs); i++)
+    {
+        alg = sha2_algs[i];
+        if ((backends & sha2_ce_bit(alg)) == 0)
+        {
+            LOG(TEST, "\tNo crypto extension for SHA-2 alg %d, portable path only\n", alg);
+            continue;
+        }
+
+        for (j = 0; j < ARRAY_SIZE(sha2_cross_len); j++)
+        {
+            if (val_sha2_digest(PAL_SHA2_BACKEND_C, alg, sha2_buf, sha2_cross_len[j], digest_c) ||
+                val_sha2_digest(sha2_ce_bit(alg), alg, sha2_buf, sha2_cross_len[j], digest_ce) ||
+                val_memcmp(digest_c, digest_ce, PAL_SHA2_DIGEST_SIZE(alg)))
+            {
+                LOG(ERROR, "Backends disagree, alg %d len 0x%lx\n", alg, sha2_cross_len[j]);
+                val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+                goto exit;
+            }
+        }
+    }
+
+    /* SHA-384 shares the SHA-512 block function, time SHA-256 and SHA-512 only */
+    LOG(ALWAYS, "SHA-256 portable: %lu KB/s\n", sha2_throughput(PAL_SHA2_BACKEND_C,
+                                                                PAL_SHA2_ALG_SHA256));
+    if (backends & PAL_SHA2_BACKEND_CE_SHA256)
+        LOG(ALWAYS, "SHA-256 crypto extension: %lu KB/s\n",
+            sha2_throughput(PAL_SHA2_BACKEND_CE_SHA256, PAL_SHA2_ALG_SHA256));
+
+    LOG(ALWAYS, "SHA-512 portable: %lu KB/s\n", sha2_throughput(PAL_SHA2_BACKEND_C,
+                                                                PAL_SHA2_ALG_SHA512));
+    if (backends & PAL_SHA2_BACKEND_CE_SHA512)
+        LOG(ALWAYS, "SHA-512 crypto extension: %lu KB/s\n",
+            sha2_throughput(PAL_SHA2_BACKEND_CE_SHA512, PAL_SHA2_ALG_SHA512));
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+exit:
+    val_realm_return_to_host();
+}
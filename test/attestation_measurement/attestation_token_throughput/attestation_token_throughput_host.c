@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_host_command.h"
+
+void attestation_token_throughput_host(void)
+{
+    val_host_realm_ts realm;
+    uint64_t ret;
+
+    val_memset(&realm, 0, sizeof(realm));
+
+    val_host_realm_params(&realm);
+
+    /* Populate realm with one REC*/
+    if (val_host_realm_setup(&realm, 1))
+    {
+        LOG(ERROR, "Realm setup failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto destroy_realm;
+    }
+
+    ret = val_host_rmi_rec_enter(realm.rec[0], realm.run[0]);
+    if (ret)
+    {
+        LOG(ERROR, "Rec enter failed, ret=%x\n", ret);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto destroy_realm;
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+destroy_realm:
+    return;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "test_database.h"
+#include "val_realm_framework.h"
+#include "val_realm_rsi.h"
+#include "val_timer.h"
+#include "attestation_realm.h"
+
+/* Stop after this many verifications or after one second, whichever comes first */
+#define THROUGHPUT_MAX_TOKENS   1000U
+
+static __attribute__((aligned (PAGE_SIZE))) uint64_t token[MAX_REALM_CCA_TOKEN_SIZE/8];
+
+void attestation_token_throughput_realm(void)
+{
+    val_smc_param_ts args = {0,};
+    uint64_t token_size = 0, ret;
+    uint64_t start, elapsed, freq, count;
+    uint64_t challenge[8] = {0xb4ea40d262abaf22,
+                             0xe8d966127b6d78e2,
+                             0x7ce913f20b954277,
+                             0x3155ff12580f9e60,
+                             0x8a3843cb95120bf6,
+                             0xd52c4fca64420f43,
+                             0xb75961661d52e8ce,
+                             0xc7f17650fe9fca60};
+    attestation_token_ts attestation_token;
+
+    args = val_realm_rsi_attestation_token_init(challenge[0], challenge[1],
+                                                  challenge[2], challenge[3], challenge[4],
+                                                 challenge[5], challenge[6], challenge[7]);
+    if (args.x0)
+    {
+        LOG(ERROR, "Token init failed, ret=%x\n", args.x0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto exit;
+    }
+
+    args.x0 = val_realm_rsi_attestation_token_fetch((uint8_t *)token, sizeof(token),
+                                                     &token_size);
+    if (args.x0)
+    {
+        LOG(ERROR, "Token continue failed, ret=%x\n", args.x0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto exit;
+    }
+
+    /* Verify the same token back to back and report the rate */
+    freq = val_read_cntfrq_el0();
+    start = val_read_cntpct_el0();
+    elapsed = 0;
+    for (count = 0; (count < THROUGHPUT_MAX_TOKENS) && (elapsed < freq); count++)
+    {
+        ret = val_attestation_verify_token(&attestation_token, challenge,
+                            ATTEST_CHALLENGE_SIZE_64, token, token_size);
+        if (ret != VAL_SUCCESS)
+        {
+            LOG(ERROR, "Verification %lu failed, ret=%x offset=0x%lx\n",
+                count, ret, attestation_token.error_offset);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+            goto exit;
+        }
+
+        elapsed = val_read_cntpct_el0() - start;
+    }
+
+    if (elapsed == 0)
+        elapsed = 1;
+
+    LOG(ALWAYS, "Verified %lu tokens of %lu bytes in %lu ticks, %lu tokens/s\n",
+        count, token_size, elapsed, (count * freq) / elapsed);
+
+    /* A token cut short must be rejected at an offset inside the data it was given */
+    ret = val_attestation_verify_token(&attestation_token, challenge,
+                        ATTEST_CHALLENGE_SIZE_64, token, token_size / 2);
+    if ((ret == VAL_SUCCESS) || (attestation_token.error_offset > token_size / 2))
+    {
+        LOG(ERROR, "Truncated token accepted or bad offset, ret=%x offset=0x%lx\n",
+            ret, attestation_token.error_offset);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(4)));
+        goto exit;
+    }
+
+exit:
+    val_realm_return_to_host();
+}
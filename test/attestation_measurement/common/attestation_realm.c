@@ -6,22 +6,181 @@
  */
 
 #include "attestation_realm.h"
+#include <stddef.h>
+
+/* Claim value checks beyond the CBOR data type */
+typedef enum {
+    ATTEST_CHECK_NONE = 0,
+    ATTEST_CHECK_CHALLENGE,
+    ATTEST_CHECK_PUB_KEY,
+    ATTEST_CHECK_REM,
+    ATTEST_CHECK_SW_COMPS
+} attest_check_te;
+
+/* Allowed byte string sizes, 0 when any size is accepted */
+#define ATTEST_LEN_32       (1U << 0)
+#define ATTEST_LEN_33       (1U << 1)
+#define ATTEST_LEN_48       (1U << 2)
+#define ATTEST_LEN_64       (1U << 3)
+#define ATTEST_LEN_HASH     (ATTEST_LEN_32 | ATTEST_LEN_48 | ATTEST_LEN_64)
+
+typedef struct {
+    int64_t label;
+    uint8_t data_type;
+    uint8_t len_mask;
+    uint8_t check;
+    /* Offset of the attestation_token_ts field to record the value in */
+    uint8_t field;
+    const char *name;
+} attest_claim_ts;
+
+#define ATTEST_FIELD(f)     (uint8_t)offsetof(attestation_token_ts, f)
+#define ATTEST_NO_FIELD     0xFFU
+
+/* Bitmap with one bit per entry of a claim table */
+#define ATTEST_ALL_CLAIMS(t) ((1U << ARRAY_SIZE(t)) - 1)
+
+/* All platform claims but one must be present */
+#define ATTEST_MIN_PLATFORM_CLAIMS (ARRAY_SIZE(platform_claims) - 1)
+
+static const attest_claim_ts realm_claims[] = {
+    {CCA_REALM_CHALLENGE, QCBOR_TYPE_BYTE_STRING, ATTEST_LEN_64,
+        ATTEST_CHECK_CHALLENGE, ATTEST_FIELD(challenge), "Realm challenge"},
+    {CCA_REALM_PERSONALIZATION_VALUE, QCBOR_TYPE_BYTE_STRING, ATTEST_LEN_64,
+        ATTEST_CHECK_NONE, ATTEST_FIELD(rpv), "Realm personalization value"},
+    {CCA_REALM_INITIAL_MEASUREMENT, QCBOR_TYPE_BYTE_STRING, ATTEST_LEN_HASH,
+        ATTEST_CHECK_NONE, ATTEST_FIELD(realm_initial_measurement), "Realm initial measurement"},
+    {CCA_REALM_PUBLIC_KEY, QCBOR_TYPE_BYTE_STRING, 0,
+        ATTEST_CHECK_PUB_KEY, ATTEST_NO_FIELD, "Realm public key"},
+    {CCA_REALM_HASH_ALGO_ID, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Realm hash algo id"},
+    {CCA_REALM_PUBLIC_KEY_HASH_ALGO_ID, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Realm public key hash algo id"},
+    {CCA_REALM_EXTENSIBLE_MEASUREMENT, QCBOR_TYPE_ARRAY, 0,
+        ATTEST_CHECK_REM, ATTEST_NO_FIELD, "Realm extensible measurement"},
+};
+
+static const attest_claim_ts platform_claims[] = {
+    {CCA_PLATFORM_PROFILE, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Platform profile"},
+    {CCA_PLATFORM_VERIFICATION_SERVICE, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Platform verification service"},
+    {CCA_PLATFORM_HASH_ALGO_ID, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Platform hash algo id"},
+    {CCA_PLATFORM_CHALLENGE, QCBOR_TYPE_BYTE_STRING, ATTEST_LEN_HASH,
+        ATTEST_CHECK_NONE, ATTEST_FIELD(platform_attest_challenge), "Platform challenge"},
+    {CCA_PLATFORM_IMPLEMENTATION_ID, QCBOR_TYPE_BYTE_STRING, ATTEST_LEN_32,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Platform implementation id"},
+    {CCA_PLATFORM_INSTANCE_ID, QCBOR_TYPE_BYTE_STRING, ATTEST_LEN_33,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Platform instance id"},
+    {CCA_PLATFORM_CONFIG, QCBOR_TYPE_BYTE_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Platform config"},
+    {CCA_PLATFORM_LIFECYCLE, QCBOR_TYPE_INT64, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Platform lifecycle"},
+    {CCA_PLATFORM_SW_COMPONENTS, QCBOR_TYPE_ARRAY, 0,
+        ATTEST_CHECK_SW_COMPS, ATTEST_NO_FIELD, "Software components"},
+};
+
+static const attest_claim_ts sw_comp_fields[] = {
+    {CCA_PLATFORM_SW_COMPONENT_TYPE, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Software component type"},
+    {CCA_PLATFORM_SW_COMPONENT_MEASUREMENT_VALUE, QCBOR_TYPE_BYTE_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Software component measurement value"},
+    {CCA_PLATFORM_SW_COMPONENT_VERSION, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Software component version"},
+    {CCA_PLATFORM_SW_COMPONENT_SIGNER_ID, QCBOR_TYPE_BYTE_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Software component signer id"},
+    {CCA_PLATFORM_SW_COMPONENT_ALGORITHM_ID, QCBOR_TYPE_TEXT_STRING, 0,
+        ATTEST_CHECK_NONE, ATTEST_NO_FIELD, "Software component algorithm"},
+};
+
+/* State of one walk over the token */
+typedef struct {
+    attestation_token_ts *attestation_token;
+    struct q_useful_buf_c challenge;
+    const uint8_t *base;
+    /* End offset of the last string item decoded, the closest known position */
+    size_t pos;
+    /* RAK of the realm token as an uncompressed P-384 point */
+    uint8_t rak[CCA_BYTE_SIZE_97];
+    bool rak_valid;
+} attest_walk_ts;
 
-uint32_t    mandatory_realm_claims = 0;
-uint32_t    mandatory_platform_claims = 0;
-uint32_t    mandatory_sw_comp_fields = 0;
+/**
+    @brief    - Find the table entry of a claim label.
+    @param    - table : Claim table
+                count : Number of entries in the table
+                label : Claim label
+    @return   - Index of the entry, count when the label is unknown.
+**/
+static uint32_t attest_claim_index(const attest_claim_ts *table, uint32_t count, int64_t label)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (table[i].label == label)
+            break;
+    }
+
+    return i;
+}
+
+/**
+    @brief    - Decode the next item and track the walk position.
+    @param    - walk           : Walk state
+                decode_context : Decoder context
+                item           : Decoded item
+    @return   - QCBOR error status.
+**/
+static uint64_t attest_next(attest_walk_ts *walk, QCBORDecodeContext *decode_context,
+                            QCBORItem *item)
+{
+    uint64_t status = QCBORDecode_GetNext(decode_context, item);
+
+    if (status == QCBOR_SUCCESS && (item->uDataType == QCBOR_TYPE_BYTE_STRING ||
+                                    item->uDataType == QCBOR_TYPE_TEXT_STRING))
+    {
+        walk->pos = (size_t)((const uint8_t *)item->val.string.ptr - walk->base) +
+                                                              item->val.string.len;
+    }
+
+    return status;
+}
+
+/**
+    @brief    - Record the offset of a malformed item and fail the walk.
+    @param    - walk : Walk state
+                item : Malformed item, NULL when it was not decoded
+    @return   - VAL_ERROR.
+**/
+static uint64_t attest_fail(attest_walk_ts *walk, const QCBORItem *item)
+{
+    size_t offset = walk->pos;
+
+    if (item && (item->uDataType == QCBOR_TYPE_BYTE_STRING ||
+                 item->uDataType == QCBOR_TYPE_TEXT_STRING))
+        offset = (size_t)((const uint8_t *)item->val.string.ptr - walk->base);
+
+    walk->attestation_token->error_offset = offset;
+    LOG(ERROR, "Malformed attestation token item at offset 0x%lx\n", offset);
+    return VAL_ERROR;
+}
 
 /**
     @brief    - API to validate Realm Public Key structure,
+                and extract the RAK when it is an EC2 P-384 key.
     @param    - KeyBstr : Realm Public Key binary string.
+                walk    : Walk state receiving the RAK
     @return   - Error status.
 **/
-static uint64_t validate_realm_pub_key(UsefulBufC KeyBstr)
+static uint64_t validate_realm_pub_key(UsefulBufC KeyBstr, attest_walk_ts *walk)
 {
     uint64_t status;
     QCBORDecodeContext ctx;
     QCBORItem item;
     bool pub_key_type_present = false;
+    uint32_t coords = 0;
 
     /* Initialize Realm Public Key decoding */
     QCBORDecode_Init(&ctx, KeyBstr, QCBOR_DECODE_MODE_NORMAL);
@@ -42,6 +201,15 @@ static uint64_t validate_realm_pub_key(UsefulBufC KeyBstr)
         if (item.uLabelType == QCBOR_TYPE_INT64) {
             if (item.label.int64 == CCA_REALM_PUBLIC_KEY_TYPE) {
                 pub_key_type_present = true;
+            } else if ((item.label.int64 == CCA_REALM_PUBLIC_KEY_X ||
+                        item.label.int64 == CCA_REALM_PUBLIC_KEY_Y) &&
+                       item.uDataType == QCBOR_TYPE_BYTE_STRING &&
+                       item.val.string.len == CCA_BYTE_SIZE_48) {
+                /* Uncompressed point: 0x04 || X || Y */
+                val_memcpy(walk->rak + 1 + ((item.label.int64 == CCA_REALM_PUBLIC_KEY_X) ?
+                                            0 : CCA_BYTE_SIZE_48),
+                           item.val.string.ptr, CCA_BYTE_SIZE_48);
+                coords++;
             }
         }
     }
@@ -60,334 +228,278 @@ static uint64_t validate_realm_pub_key(UsefulBufC KeyBstr)
         return VAL_ERROR;
     }
 
+    walk->rak[0] = 0x04;
+    walk->rak_valid = (coords == 2);
+
     return VAL_SUCCESS;
 }
 
 /**
-    @brief    - This API will verify the claims for realm token
-    @param    - decode_context      : The buffer containing the challenge
-                item                : context for decoding the data items
-                completed_challenge : Buffer containing the challenge
+    @brief    - Check the software components array of the platform token.
+    @param    - walk           : Walk state
+                decode_context : Decoder context positioned after the array
+                item           : Decoded array item
     @return   - error status
 **/
-static uint64_t parse_claims_realm_token(attestation_token_ts *attestation_token,
-                                         QCBORDecodeContext *decode_context, QCBORItem item,
-                                         struct q_useful_buf_c completed_challenge)
+static uint64_t attest_check_sw_comps(attest_walk_ts *walk, QCBORDecodeContext *decode_context,
+                                      QCBORItem *item)
 {
-    uint64_t status = VAL_SUCCESS;
-    int i, count = 0;
+    uint32_t index, sw_comp_count = item->val.uCount;
+    uint32_t i, count, found, mandatory_fields;
+    uint8_t nesting;
 
-    /* Parse each claim and validate their data type */
-    while (status == VAL_SUCCESS)
+    for (index = 0; index < sw_comp_count; index++)
     {
-        status = QCBORDecode_GetNext(decode_context, &item);
-        if (status != VAL_SUCCESS)
-            break;
+        if (attest_next(walk, decode_context, item) != QCBOR_SUCCESS ||
+            item->uDataType != QCBOR_TYPE_MAP)
+        {
+            LOG(ERROR, "Software components is not in expected format.\n");
+            return attest_fail(walk, item);
+        }
+
+        count = item->val.uCount;
+        nesting = item->uNextNestLevel;
+        mandatory_fields = 0;
 
-        if (item.uLabelType == QCBOR_TYPE_INT64)
+        i = 0;
+        while (i < count)
         {
-            if (item.label.int64 == CCA_REALM_CHALLENGE)
+            if (attest_next(walk, decode_context, item) != QCBOR_SUCCESS)
             {
-                mandatory_realm_claims = mandatory_realm_claims + 1;
-                if (item.uDataType == QCBOR_TYPE_BYTE_STRING &&
-                    item.val.string.len == CCA_BYTE_SIZE_64)
-                {
-                    attestation_token->challenge = item.val.string;
-                    /* Given challenge vs challenge in token */
-                    if (UsefulBuf_Compare(item.val.string, completed_challenge))
-                    {
-                        LOG(ERROR, "Realm challenge and given challenge are not same.\n");
-                        return VAL_ERROR;
-                    }
-                }
-                else
-                {
-                    LOG(ERROR, "Realm challenge is not in expected format.\n");
-                    return VAL_ERROR;
-                }
-            }
-            else if (item.label.int64 == CCA_REALM_PERSONALIZATION_VALUE)
-            {
-                mandatory_realm_claims = mandatory_realm_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                {
-                    LOG(ERROR, "Realm personalization value is not in expected format.\n");
-                    return VAL_ERROR;
-                }
-                if (item.val.string.len != CCA_BYTE_SIZE_64)
-                {
-                    LOG(ERROR, "Realm personalization value size is incorrect.\n");
-                    return VAL_ERROR;
-                }
-                attestation_token->rpv = item.val.string;
-            }
-            else if (item.label.int64 == CCA_REALM_INITIAL_MEASUREMENT)
-            {
-                mandatory_realm_claims = mandatory_realm_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                {
-                    LOG(ERROR, "Realm initial measurement is not in expected format.\n");
-                    return VAL_ERROR;
-                }
-                if (item.val.string.len != CCA_BYTE_SIZE_32 &&
-                    item.val.string.len != CCA_BYTE_SIZE_48 &&
-                    item.val.string.len != CCA_BYTE_SIZE_64)
-                {
-                    LOG(ERROR, "Realm initial measurement is not in given size format.\n");
-                    return VAL_ERROR;
-                }
-                attestation_token->realm_initial_measurement = item.val.string;
+                LOG(ERROR, "No next software components available.\n");
+                return attest_fail(walk, NULL);
             }
-            else if (item.label.int64 == CCA_REALM_PUBLIC_KEY)
-            {
-                mandatory_realm_claims = mandatory_realm_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                {
-                    LOG(ERROR, "Realm public key is not in expected format.\n");
-                    return VAL_ERROR;
-                }
 
-                /* Realm public key should be of type COSE_Key defined in RFC 8152 protocol*/
-                if (validate_realm_pub_key(item.val.string)) {
-                    LOG(ERROR, "Realm public key is not in expected format.\n");
-                    return VAL_ERROR;
-                }
-            }
-            else if (item.label.int64 == CCA_REALM_HASH_ALGO_ID ||
-                     item.label.int64 == CCA_REALM_PUBLIC_KEY_HASH_ALGO_ID)
-            {
-                mandatory_realm_claims = mandatory_realm_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_TEXT_STRING)
-                {
-                    LOG(ERROR, "Realm hash algo/public key hash algo id is \
-                                                 not in expected format.\n");
-                    return VAL_ERROR;
-                }
-            }
-            else if (item.label.int64 == CCA_REALM_EXTENSIBLE_MEASUREMENT)
-            {
-                mandatory_realm_claims = mandatory_realm_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_ARRAY)
-                {
-                    LOG(ERROR, "Realm extensible measurement is not in expected format.\n");
-                    return VAL_ERROR;
-                }
+            /* Skip the contents of nested fields */
+            if (item->uNestingLevel != nesting)
+                continue;
 
-                count = item.val.uCount;
-                for (i = 0 ; i < count ; i++)
-                {
-                    status = QCBORDecode_GetNext(decode_context, &item);
-                    attestation_token->rem[i] = item.val.string;
-                }
+            i++;
+
+            if (item->uLabelType != QCBOR_TYPE_INT64)
+                continue;
+
+            found = attest_claim_index(sw_comp_fields, ARRAY_SIZE(sw_comp_fields),
+                                                                item->label.int64);
+            if (found == ARRAY_SIZE(sw_comp_fields))
+                continue;
+
+            mandatory_fields++;
+            if (item->uDataType != sw_comp_fields[found].data_type)
+            {
+                LOG(ERROR, "%s is not in expected format.\n", sw_comp_fields[found].name);
+                return attest_fail(walk, item);
             }
         }
-        else
+
+        if (mandatory_fields < 2)
         {
-            /* For other claim types */
+            LOG(ERROR, " mandatory sw_components fields are absent\n");
+            return attest_fail(walk, NULL);
         }
     }
 
-    if (status == QCBOR_ERR_HIT_END || status == QCBOR_ERR_NO_MORE_ITEMS)
-        return VAL_SUCCESS;
-    else
-        return VAL_ERROR;
+    return VAL_SUCCESS;
 }
 
 /**
-    @brief    - This API will verify the claims for platform token
-    @param    - decode_context      : The buffer containing the challenge
-                item                : context for decoding the data items
+    @brief    - Check one claim against its table entry.
+    @param    - walk           : Walk state
+                decode_context : Decoder context positioned after the claim
+                item           : Decoded claim
+                claim          : Table entry of the claim
     @return   - error status
 **/
-static uint64_t parse_claims_platform_token(attestation_token_ts *attestation_token,
-                                            QCBORDecodeContext *decode_context, QCBORItem item)
+static uint64_t attest_check_claim(attest_walk_ts *walk, QCBORDecodeContext *decode_context,
+                                   QCBORItem *item, const attest_claim_ts *claim)
 {
-    int i, count = 0, sw_comp_count = 0, index = 0;
-    uint64_t status = VAL_SUCCESS;
+    attestation_token_ts *attestation_token = walk->attestation_token;
+    uint32_t i, count, len_bit = 0;
 
-    /* Parse each claim and validate their data type */
-    while (status == VAL_SUCCESS)
+    if (item->uDataType != claim->data_type)
     {
-        status = QCBORDecode_GetNext(decode_context, &item);
-        if (status != VAL_SUCCESS)
-            break;
+        LOG(ERROR, "%s is not in expected format.\n", claim->name);
+        return attest_fail(walk, item);
+    }
 
-        if (item.uLabelType == QCBOR_TYPE_INT64)
+    if (claim->len_mask)
+    {
+        switch (item->val.string.len)
         {
-            if (item.label.int64 == CCA_PLATFORM_PROFILE ||
-                item.label.int64 == CCA_PLATFORM_VERIFICATION_SERVICE ||
-                item.label.int64 == CCA_PLATFORM_HASH_ALGO_ID)
-            {
-                mandatory_platform_claims = mandatory_platform_claims + 1;
+            case CCA_BYTE_SIZE_32:
+                len_bit = ATTEST_LEN_32;
+                break;
+            case CCA_BYTE_SIZE_33:
+                len_bit = ATTEST_LEN_33;
+                break;
+            case CCA_BYTE_SIZE_48:
+                len_bit = ATTEST_LEN_48;
+                break;
+            case CCA_BYTE_SIZE_64:
+                len_bit = ATTEST_LEN_64;
+                break;
+            default:
+                break;
+        }
 
-                if (item.uDataType != QCBOR_TYPE_TEXT_STRING)
-                {
-                    LOG(ERROR, "Platform token profile/verification-service/hash algo is \
-                                                              not in expected format.\n");
-                    return VAL_ERROR;
-                }
-            }
-            else if (item.label.int64 == CCA_PLATFORM_CHALLENGE)
-            {
-                mandatory_platform_claims = mandatory_platform_claims + 1;
+        if (!(len_bit & claim->len_mask))
+        {
+            LOG(ERROR, "%s size is incorrect.\n", claim->name);
+            return attest_fail(walk, item);
+        }
+    }
 
-                if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                {
-                    LOG(ERROR, "Platform challenge is not in expected format.\n");
-                    return VAL_ERROR;
-                }
-                if (item.val.string.len != CCA_BYTE_SIZE_32 &&
-                    item.val.string.len != CCA_BYTE_SIZE_48 &&
-                    item.val.string.len != CCA_BYTE_SIZE_64)
-                {
-                    LOG(ERROR, "Platform challenge size is incorrect.\n");
-                    return VAL_ERROR;
-                }
-                attestation_token->platform_attest_challenge = item.val.string;
-            }
-            else if (item.label.int64 == CCA_PLATFORM_IMPLEMENTATION_ID)
+    if (claim->field != ATTEST_NO_FIELD)
+        *(struct q_useful_buf_c *)((uint8_t *)attestation_token + claim->field) =
+                                                                  item->val.string;
+
+    switch (claim->check)
+    {
+        case ATTEST_CHECK_CHALLENGE:
+            /* Given challenge vs challenge in token */
+            if (UsefulBuf_Compare(item->val.string, walk->challenge))
             {
-                mandatory_platform_claims = mandatory_platform_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                {
-                    LOG(ERROR, "Platform implementation id is not in expected format.\n");
-                    return VAL_ERROR;
-                }
-                if (item.val.string.len != CCA_BYTE_SIZE_32)
-                {
-                    LOG(ERROR, "Platform implementation id size is incorrect.\n");
-                    return VAL_ERROR;
-                }
+                LOG(ERROR, "Realm challenge and given challenge are not same.\n");
+                return attest_fail(walk, item);
             }
-            else if (item.label.int64 == CCA_PLATFORM_INSTANCE_ID)
+            break;
+
+        case ATTEST_CHECK_PUB_KEY:
+            /* Realm public key should be of type COSE_Key defined in RFC 8152 protocol*/
+            if (validate_realm_pub_key(item->val.string, walk))
             {
-                mandatory_platform_claims = mandatory_platform_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                {
-                    LOG(ERROR, "Platform instance id is not in expected format.\n");
-                    return VAL_ERROR;
-                }
-                if (item.val.string.len != CCA_BYTE_SIZE_33)
-                {
-                    LOG(ERROR, "Platform instance id size is incorrect.\n");
-                    return VAL_ERROR;
-                }
+                LOG(ERROR, "%s is not in expected format.\n", claim->name);
+                return attest_fail(walk, item);
             }
-            else if (item.label.int64 == CCA_PLATFORM_CONFIG)
-            {
-                mandatory_platform_claims = mandatory_platform_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                {
-                    LOG(ERROR, "Platform config is not in expected format.\n");
-                    return VAL_ERROR;
-                }            }
-            else if (item.label.int64 == CCA_PLATFORM_LIFECYCLE)
-            {
-                mandatory_platform_claims = mandatory_platform_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_INT64)
-                {
-                    LOG(ERROR, "Platform lifecycle is not in expected format.\n");
-                    return VAL_ERROR;
-                }            }
-            else if (item.label.int64 == CCA_PLATFORM_SW_COMPONENTS)
+            break;
+
+        case ATTEST_CHECK_REM:
+            count = item->val.uCount;
+            for (i = 0; i < count; i++)
             {
-                mandatory_platform_claims = mandatory_platform_claims + 1;
-                if (item.uDataType != QCBOR_TYPE_ARRAY)
+                if (attest_next(walk, decode_context, item) != QCBOR_SUCCESS ||
+                    item->uDataType != QCBOR_TYPE_BYTE_STRING)
                 {
-                    LOG(ERROR, "Software components is not in expected format.\n");
-                    return VAL_ERROR;
+                    LOG(ERROR, "%s is not in expected format.\n", claim->name);
+                    return attest_fail(walk, item);
                 }
-                sw_comp_count = item.val.uCount;
-                for (index = 0; index < sw_comp_count; index++)
-                {
-                    status = QCBORDecode_GetNext(decode_context, &item);
-                    if (status != VAL_SUCCESS)
-                       continue;
-
-                    count = item.val.uCount;
-                    for (i = 0; i <= count; i++)
-                    {
-                        if (item.label.int64 == CCA_PLATFORM_SW_COMPONENT_TYPE ||
-                            item.label.int64 == CCA_PLATFORM_SW_COMPONENT_VERSION ||
-                            item.label.int64 == CCA_PLATFORM_SW_COMPONENT_ALGORITHM_ID)
-                        {
-                            mandatory_sw_comp_fields++;
-                            if (item.uDataType != QCBOR_TYPE_TEXT_STRING)
-                            {
-                                LOG(ERROR, "Software component type/version/algorithm is \
-                                                               not in expected format.\n");
-                                return VAL_ERROR;
-                            }
-                        }
-                        else if (item.label.int64 == CCA_PLATFORM_SW_COMPONENT_MEASUREMENT_VALUE ||
-                                 item.label.int64 == CCA_PLATFORM_SW_COMPONENT_SIGNER_ID)
-                        {
-                            mandatory_sw_comp_fields++;
-                            if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
-                            {
-                                LOG(ERROR, "Software component measurement value/signer is \
-                                                                 not in expected format.\n");
-                                return VAL_ERROR;
-                            }
-                        }
-
-                        if (i < count)
-                        {
-                            status = QCBORDecode_GetNext(decode_context, &item);
-                            if (status != VAL_SUCCESS)
-                            {
-                                LOG(ERROR, "No next software components available.\n");
-                                return VAL_ERROR;
-                            }
-                        }
-                    } /*for (i = 0; i <= count; i++)*/
-
-                    if (mandatory_sw_comp_fields < 2) {
-                        LOG(ERROR, " mandatory sw_components fields are absent\n");
-                        return VAL_ERROR;
-                    }
-
-                    mandatory_sw_comp_fields = 0;
-
-                } /*for (index = 0; index<sw_comp_count; index++)*/
+
+                if (i < sizeof(attestation_token->rem) / sizeof(attestation_token->rem[0]))
+                    attestation_token->rem[i] = item->val.string;
             }
-        }
-        else
-        {
-            /* For other claim types */
-        }
+            break;
+
+        case ATTEST_CHECK_SW_COMPS:
+            return attest_check_sw_comps(walk, decode_context, item);
+
+        default:
+            break;
+    }
+
+    return VAL_SUCCESS;
+}
+
+/**
+    @brief    - Walk a claims map once, dispatching each top level claim through its table.
+    @param    - walk    : Walk state
+                payload : Byte string holding the claims map
+                table   : Claim table
+                count   : Number of entries in the table
+                seen    : Bitmap of the table entries found in the map
+    @return   - error status
+**/
+static uint64_t attest_walk_claims(attest_walk_ts *walk, struct q_useful_buf_c payload,
+                                   const attest_claim_ts *table, uint32_t count, uint32_t *seen)
+{
+    QCBORDecodeContext decode_context;
+    QCBORItem item;
+    uint64_t status;
+    uint32_t found;
+    uint8_t nesting;
+
+    QCBORDecode_Init(&decode_context, payload, QCBOR_DECODE_MODE_NORMAL);
+    walk->pos = (size_t)((const uint8_t *)payload.ptr - walk->base);
+
+    status = attest_next(walk, &decode_context, &item);
+    if (status != QCBOR_SUCCESS || item.uDataType != QCBOR_TYPE_MAP)
+    {
+        LOG(ERROR, " Attestation token error formatting\n");
+        return attest_fail(walk, NULL);
     }
 
-    if (status == QCBOR_ERR_HIT_END || status == QCBOR_ERR_NO_MORE_ITEMS)
-        return VAL_SUCCESS;
-    else
+    nesting = item.uNextNestLevel;
+    *seen = 0;
+
+    while ((status = attest_next(walk, &decode_context, &item)) == QCBOR_SUCCESS)
     {
-        LOG(ERROR, "Realm challenge is not in expected format.\n");
-        return VAL_ERROR;
+        /* Only top level claims are dispatched, unknown claim contents are skipped */
+        if (item.uNestingLevel != nesting || item.uLabelType != QCBOR_TYPE_INT64)
+            continue;
+
+        found = attest_claim_index(table, count, item.label.int64);
+        if (found == count)
+            continue;
+
+        *seen |= (1U << found);
+        if (attest_check_claim(walk, &decode_context, &item, &table[found]))
+            return VAL_ERROR;
     }
+
+    if (status != QCBOR_ERR_HIT_END && status != QCBOR_ERR_NO_MORE_ITEMS)
+    {
+        LOG(ERROR, "Claims decoding failed, status=%x\n", status);
+        return attest_fail(walk, NULL);
+    }
+
+    return VAL_SUCCESS;
 }
 
-uint64_t val_attestation_verify_token(attestation_token_ts *attestation_token,
-            uint64_t *challenge, __attribute__((unused)) size_t challenge_size,
-                                        uint64_t *token, size_t token_size)
+/**
+    @brief    - Check that a COSE protected header selects ES384.
+    @param    - protected_hdr : Byte string holding the protected header map
+    @return   - error status
+**/
+static uint64_t attest_check_alg_es384(struct q_useful_buf_c protected_hdr)
 {
-    uint64_t               status = VAL_SUCCESS;
-    QCBORItem             item;
-    QCBORDecodeContext    decode_context;
-    struct q_useful_buf_c completed_challenge;
-    struct q_useful_buf_c completed_token;
-    struct q_useful_buf_c platform_token_payload;
-    struct q_useful_buf_c realm_token_payload;
-    struct q_useful_buf_c payload1;
-    struct q_useful_buf_c payload2;
+    QCBORDecodeContext decode_context;
+    QCBORItem item;
+    bool es384 = false;
 
-    /* Construct the token buffer for validation */
-    completed_token.ptr = token;
-    completed_token.len = token_size;
+    QCBORDecode_Init(&decode_context, protected_hdr, QCBOR_DECODE_MODE_NORMAL);
+
+    if (QCBORDecode_GetNext(&decode_context, &item) != QCBOR_SUCCESS ||
+        item.uDataType != QCBOR_TYPE_MAP)
+        return VAL_ERROR;
+
+    while (QCBORDecode_GetNext(&decode_context, &item) == QCBOR_SUCCESS)
+    {
+        if (item.uLabelType == QCBOR_TYPE_INT64 && item.label.int64 == COSE_HEADER_ALG &&
+            item.uDataType == QCBOR_TYPE_INT64 && item.val.int64 == COSE_ALG_ES384)
+            es384 = true;
+    }
 
-    /* Construct the challenge buffer for validation */
-    completed_challenge.ptr = challenge;
-    completed_challenge.len = challenge_size;
+    if (QCBORDecode_Finish(&decode_context) != QCBOR_SUCCESS || !es384)
+        return VAL_ERROR;
+
+    return VAL_SUCCESS;
+}
+
+/**
+    @brief    - Walk a COSE_Sign1 structure and return its parts.
+    @param    - walk    : Walk state
+                sign1   : Byte string holding the COSE_Sign1 structure
+                payload : Payload of the structure
+                parts   : Protected header, payload and signature of the structure
+    @return   - error status
+**/
+static uint64_t attest_walk_sign1(attest_walk_ts *walk, struct q_useful_buf_c sign1,
+                                  struct q_useful_buf_c *payload, pal_cose_sign1_ts *parts)
+{
+    QCBORDecodeContext decode_context;
+    QCBORItem item;
+    struct q_useful_buf_c protected_hdr = {NULL, 0};
+    uint32_t index = 0;
+    uint8_t nesting;
 
 /*      COSE_Sign1 Format
     -------------------------
@@ -402,121 +514,179 @@ uint64_t val_attestation_verify_token(attestation_token_ts *attestation_token,
     |  Signature            |
     -------------------------
 */
+    QCBORDecode_Init(&decode_context, sign1, QCBOR_DECODE_MODE_NORMAL);
+    walk->pos = (size_t)((const uint8_t *)sign1.ptr - walk->base);
+
+    if (attest_next(walk, &decode_context, &item) != QCBOR_SUCCESS ||
+        item.uDataType != QCBOR_TYPE_ARRAY || item.val.uCount != 4 ||
+        !QCBORDecode_IsTagged(&decode_context, &item, CBOR_TAG_COSE_SIGN1))
+    {
+        LOG(ERROR, " Attestation token error formatting\n");
+        return attest_fail(walk, NULL);
+    }
+
+    nesting = item.uNextNestLevel;
+    while (index < 4)
+    {
+        if (attest_next(walk, &decode_context, &item) != QCBOR_SUCCESS)
+        {
+            LOG(ERROR, " Attestation token error formatting\n");
+            return attest_fail(walk, NULL);
+        }
+
+        /* Skip the entries of the unprotected header map */
+        if (item.uNestingLevel != nesting)
+            continue;
+
+        index++;
+
+        /* The unprotected header is the only entry that is not a byte string */
+        if (index == 2)
+            continue;
+
+        if (item.uDataType != QCBOR_TYPE_BYTE_STRING)
+        {
+            LOG(ERROR, " Attestation token error formatting\n");
+            return attest_fail(walk, &item);
+        }
+
+        if (index == 1)
+            protected_hdr = item.val.string;
+        else if (index == 3)
+            *payload = item.val.string;
+    }
+
+    if (attest_check_alg_es384(protected_hdr))
+    {
+        LOG(ERROR, " Attestation token signature algorithm is not ES384\n");
+        return attest_fail(walk, NULL);
+    }
+
+    parts->protected_hdr = protected_hdr.ptr;
+    parts->protected_len = protected_hdr.len;
+    parts->payload = payload->ptr;
+    parts->payload_len = payload->len;
+    parts->signature = item.val.string.ptr;
+    parts->signature_len = item.val.string.len;
+    return VAL_SUCCESS;
+}
+
+/**
+    @brief    - Verify a CCA attestation token. Each bstr wrapped payload is decoded
+                once, with its own QCBOR decode context.
+                On a malformed token the byte offset of the first malformed item is
+                stored in attestation_token->error_offset.
+    @param    - attestation_token : Claims extracted from the token
+                challenge         : Challenge the token was requested with
+                challenge_size    : Size of the challenge
+                token             : Token buffer
+                token_size        : Size of the token
+    @return   - error status
+**/
+uint64_t val_attestation_verify_token(attestation_token_ts *attestation_token,
+                                      uint64_t *challenge, size_t challenge_size,
+                                      uint64_t *token, size_t token_size)
+{
+    uint64_t               status;
+    QCBORItem             item;
+    QCBORDecodeContext    decode_context;
+    struct q_useful_buf_c completed_token;
+    struct q_useful_buf_c platform_token_payload;
+    struct q_useful_buf_c realm_token_payload;
+    struct q_useful_buf_c payload;
+    pal_cose_sign1_ts     platform_sign1, realm_sign1;
+    attest_walk_ts        walk;
+    uint32_t              seen, count;
+
+    /* Construct the token buffer for validation */
+    completed_token.ptr = token;
+    completed_token.len = token_size;
+
+    walk.attestation_token = attestation_token;
+    walk.challenge.ptr = challenge;
+    walk.challenge.len = challenge_size;
+    walk.base = (const uint8_t *)token;
+    walk.pos = 0;
+    walk.rak_valid = false;
+    attestation_token->error_offset = 0;
 
     /* Initialize the decorder */
     QCBORDecode_Init(&decode_context, completed_token, QCBOR_DECODE_MODE_NORMAL);
 
-    /* Get the Header */
-    QCBORDecode_GetNext(&decode_context, &item);
-
     /* Check the CBOR Map type. Check if the count is 2.
      * Only COSE_SIGN1 is supported now.
      */
-    if (item.uDataType != QCBOR_TYPE_MAP || item.val.uCount != 2 ||
-        !QCBORDecode_IsTagged(&decode_context, &item, 399))
+    status = attest_next(&walk, &decode_context, &item);
+    if (status != QCBOR_SUCCESS || item.uDataType != QCBOR_TYPE_MAP ||
+        item.val.uCount != 2 || !QCBORDecode_IsTagged(&decode_context, &item, 399))
     {
         LOG(ERROR, " Attestation token error formatting\n");
-        return VAL_ERROR;
+        return attest_fail(&walk, NULL);
     }
 
     /* Get the cca-platform token payload */
-    QCBORDecode_GetNext(&decode_context, &item);
-    if (item.uDataType != QCBOR_TYPE_BYTE_STRING || item.label.int64 != CCA_PLATFORM_TOKEN)
+    status = attest_next(&walk, &decode_context, &item);
+    if (status != QCBOR_SUCCESS || item.uDataType != QCBOR_TYPE_BYTE_STRING ||
+        item.label.int64 != CCA_PLATFORM_TOKEN)
     {
         LOG(ERROR, " Attestation token error formatting\n");
-        return VAL_ERROR;
+        return attest_fail(&walk, &item);
     }
 
     platform_token_payload = item.val.string;
 
     /* Get the realm token payload */
-    QCBORDecode_GetNext(&decode_context, &item);
-    if (item.uDataType != QCBOR_TYPE_BYTE_STRING  || item.label.int64 != CCA_REALM_TOKEN)
+    status = attest_next(&walk, &decode_context, &item);
+    if (status != QCBOR_SUCCESS || item.uDataType != QCBOR_TYPE_BYTE_STRING ||
+        item.label.int64 != CCA_REALM_TOKEN)
     {
         LOG(ERROR, " Attestation token error formatting\n");
-        return VAL_ERROR;
+        return attest_fail(&walk, &item);
     }
 
     realm_token_payload = item.val.string;
 
-    /* Initialize the Decoder and validate the cca-platform token payload format */
-    QCBORDecode_Init(&decode_context, platform_token_payload, QCBOR_DECODE_MODE_NORMAL);
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    if (status != VAL_SUCCESS)
-        return status;
-
-    if (item.uDataType != QCBOR_TYPE_ARRAY || item.val.uCount != 4 ||
-            !QCBORDecode_IsTagged(&decode_context, &item, CBOR_TAG_COSE_SIGN1))
-    {
-        LOG(ERROR, " Attestation token error formatting\n");
+    /* Validate the cca-platform token format and its claims */
+    if (attest_walk_sign1(&walk, platform_token_payload, &payload, &platform_sign1))
         return VAL_ERROR;
-    }
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    status = QCBORDecode_GetNext(&decode_context, &item);
-
-    payload1 = item.val.string;
-
-    /* Verify the signature */
-    status = pal_verify_signature(token);
-    if (status != VAL_SUCCESS)
-        return status;
 
-    QCBORDecode_Init(&decode_context, payload1, QCBOR_DECODE_MODE_NORMAL);
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    if (item.uDataType != QCBOR_TYPE_MAP)
-    {
-        LOG(ERROR, " Attestation token error formatting\n");
+    if (attest_walk_claims(&walk, payload, platform_claims, ARRAY_SIZE(platform_claims), &seen))
         return VAL_ERROR;
-    }
-    /* Parse the payload and check the data type of each claim */
-    status = parse_claims_platform_token(attestation_token, &decode_context, item);
-    if (status != VAL_SUCCESS)
-        return status;
 
-    /* Initialize the Decoder and validate the realm token payload format */
-    QCBORDecode_Init(&decode_context, realm_token_payload, QCBOR_DECODE_MODE_NORMAL);
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    if (status != VAL_SUCCESS)
-        return status;
+    for (count = 0; seen != 0; seen &= seen - 1)
+        count++;
 
-    if (item.uDataType != QCBOR_TYPE_ARRAY || item.val.uCount != 4 ||
-            !QCBORDecode_IsTagged(&decode_context, &item, CBOR_TAG_COSE_SIGN1))
+    if (count < ATTEST_MIN_PLATFORM_CLAIMS)
     {
-        LOG(ERROR, " Attestation token error formatting\n");
+        LOG(ERROR, " mandatory platform claims are absent.\n");
         return VAL_ERROR;
     }
 
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    status = QCBORDecode_GetNext(&decode_context, &item);
-
-    payload2 = item.val.string;
-    QCBORDecode_Init(&decode_context, payload2, QCBOR_DECODE_MODE_NORMAL);
+    /* Validate the realm token format and its claims */
+    if (attest_walk_sign1(&walk, realm_token_payload, &payload, &realm_sign1))
+        return VAL_ERROR;
 
+    if (attest_walk_claims(&walk, payload, realm_claims, ARRAY_SIZE(realm_claims), &seen))
+        return VAL_ERROR;
 
-    status = QCBORDecode_GetNext(&decode_context, &item);
-    if (item.uDataType != QCBOR_TYPE_MAP)
+    if (seen != ATTEST_ALL_CLAIMS(realm_claims))
     {
-        LOG(ERROR, " Attestation token error formatting\n");
+        LOG(ERROR, " mandatory realm claims are absent.\n");
         return VAL_ERROR;
     }
 
-    /* Parse the payload and check the data type of each claim */
-    status = parse_claims_realm_token(attestation_token, &decode_context, item,
-                                                          completed_challenge);
-    if (status != VAL_SUCCESS)
-        return status;
-
-    if (mandatory_realm_claims != 7)
+    /* Verify the signatures, the realm token with the RAK it carries */
+    if (!walk.rak_valid)
     {
-        LOG(ERROR, " mandatory realm claims are absent.\n");
+        LOG(ERROR, " Realm public key is not an EC2 P-384 key.\n");
         return VAL_ERROR;
     }
 
-    if (!(mandatory_platform_claims >= 8)) {
-        LOG(ERROR, " mandatory platform claims are absent.\n");
-        return VAL_ERROR;
+    status = pal_verify_signature(&platform_sign1, &realm_sign1, walk.rak, sizeof(walk.rak));
+    if (status != VAL_SUCCESS)
+    {
+        LOG(ERROR, " Attestation token signature verification failed.\n");
+        return status;
     }
 
     return VAL_SUCCESS;
@@ -55,6 +55,12 @@
 #define CCA_REALM_PUBLIC_KEY_ALGO    3
 #define CCA_REALM_PUBLIC_KEY_OPS     4
 #define CCA_ReALM_PUBLIC_KEY_BASE_IV 5
+#define CCA_REALM_PUBLIC_KEY_X       (-2)
+#define CCA_REALM_PUBLIC_KEY_Y       (-3)
+
+/* COSE protected header */
+#define COSE_HEADER_ALG              1
+#define COSE_ALG_ES384               (-35)
 
 typedef struct {
     struct q_useful_buf_c challenge;
@@ -62,6 +68,8 @@ typedef struct {
     struct q_useful_buf_c realm_initial_measurement;
     struct q_useful_buf_c platform_attest_challenge;
     struct q_useful_buf_c rem[4];
+    /* Byte offset in the token of the first malformed item */
+    size_t error_offset;
 } attestation_token_ts;
 
 uint64_t val_attestation_verify_token(attestation_token_ts *attestation_token,
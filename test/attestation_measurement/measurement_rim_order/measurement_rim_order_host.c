@@ -8,9 +8,35 @@
 #include "test_database.h"
 #include "val_host_rmi.h"
 #include "val_host_command.h"
+#include "val_host_measurement.h"
 
 #define IPA_ADDR_UNASSIGNED 0x0
 
+/* The Realm reports RSI_MEASUREMENT_READ x1-x7 in gprs[1]-gprs[7] */
+#define RIM_REPORT_SIZE     (7 * sizeof(uint64_t))
+
+/* Compare the RIM a Realm read with the host reference model */
+static uint64_t rim_check_model(uint64_t rd, val_host_rec_exit_ts *rec_exit)
+{
+    const val_host_meas_ts *meas = val_host_meas_get(rd);
+    size_t size;
+
+    if (!meas)
+    {
+        LOG(ERROR, "No reference RIM for rd 0x%lx\n", rd);
+        return VAL_ERROR;
+    }
+
+    size = (meas->size < RIM_REPORT_SIZE) ? meas->size : RIM_REPORT_SIZE;
+    if (val_memcmp(&rec_exit->gprs[1], (void *)meas->rim, size))
+    {
+        LOG(ERROR, "RIM does not match the reference model, rd 0x%lx\n", rd);
+        return VAL_ERROR;
+    }
+
+    return VAL_SUCCESS;
+}
+
 static uint64_t rec_create(uint64_t rd)
 {
     /* Delegate granule for the REC */
@@ -220,6 +246,14 @@ void measurement_rim_order_host(void)
         val_set_status(RESULT_FAIL(VAL_ERROR_POINT(13)));
         goto destroy_realm;
     }
+
+    /* Each RIM must follow its own creation order in the reference model */
+    if (rim_check_model(realm1.rd, rec_exit1) || rim_check_model(realm2.rd, rec_exit2))
+    {
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(14)));
+        goto destroy_realm;
+    }
+
     val_set_status(RESULT_PASS(VAL_SUCCESS));
 
 destroy_realm:
@@ -107,6 +107,8 @@ DECLARE_TEST_FN(measurement_immutable_rim);
 DECLARE_TEST_FN(measurement_initial_rem_is_zero);
 DECLARE_TEST_FN(measurement_rim_order);
 DECLARE_TEST_FN(attestation_token_verify);
+DECLARE_TEST_FN(attestation_token_throughput);
+DECLARE_TEST_FN(attestation_sha2_backends);
 DECLARE_TEST_FN(attestation_rpv_value);
 DECLARE_TEST_FN(attestation_challenge_data_verification);
 DECLARE_TEST_FN(attestation_token_init);
@@ -126,6 +128,7 @@ DECLARE_TEST_FN(mm_hipas_unassigned_ns_da_ia);
 DECLARE_TEST_FN(mm_unprotected_ipa_boundary);
 DECLARE_TEST_FN(mm_protected_ipa_boundary);
 DECLARE_TEST_FN(mm_gpf_exception);
+DECLARE_TEST_FN(mm_libc_paths);
 DECLARE_TEST_FN(mm_rtt_translation_table);
 DECLARE_TEST_FN(mm_rtt_fold_assigned);
 DECLARE_TEST_FN(mm_rtt_fold_unassigned);
@@ -221,6 +224,7 @@ DECLARE_TEST_FN(lfa_test);
 /*DA testcase declaration starts here*/
 DECLARE_TEST_FN(da_offchip_pcie);
 DECLARE_TEST_FN(da_pdev_single_active_transaction);
+DECLARE_TEST_FN(da_pdevs_interleaved_communicate);
 /*DA testcase declaration ends here*/
 
 /*RHI testcase declaration starts here*/
@@ -233,11 +237,13 @@ DECLARE_TEST_FN(rhi_session_send);
 DECLARE_TEST_FN(rhi_session_receive);
 DECLARE_TEST_FN(rhi_fal_features);
 DECLARE_TEST_FN(rhi_fal_read);
+DECLARE_TEST_FN(rhi_fal_stream_read);
 DECLARE_TEST_FN(rhi_da_features);
 DECLARE_TEST_FN(rhi_hostconf_features);
 DECLARE_TEST_FN(rhi_hostconf_get_ipa_change_alignment);
 DECLARE_TEST_FN(rhi_fal_get_size);
 DECLARE_TEST_FN(rhi_session_open);
+DECLARE_TEST_FN(rhi_session_multi_rec);
 DECLARE_TEST_FN(rhi_session_close);
 DECLARE_TEST_FN(rhi_da_object_size);
 DECLARE_TEST_FN(rhi_da_object_read);
@@ -629,6 +635,14 @@ DECLARE_TEST_FN(rhi_da_vdev_set_tdi_state);
         #if (defined(TEST_COMBINE) || defined(d_attestation_token_verify))
         HOST_REALM_TEST(attestation_measurement, attestation_measurement, attestation_token_verify),
         #endif
+        #if (defined(TEST_COMBINE) || defined(d_attestation_token_throughput))
+        HOST_REALM_TEST(attestation_measurement, attestation_measurement,
+                                                  attestation_token_throughput),
+        #endif
+        #if (defined(TEST_COMBINE) || defined(d_attestation_sha2_backends))
+        HOST_REALM_TEST(attestation_measurement, attestation_measurement,
+                                                  attestation_sha2_backends),
+        #endif
         #if (defined(TEST_COMBINE) || defined(d_attestation_rpv_value))
         HOST_REALM_TEST(attestation_measurement, attestation_measurement, attestation_rpv_value),
         #endif
@@ -732,6 +746,9 @@ DECLARE_TEST_FN(rhi_da_vdev_set_tdi_state);
         #if (defined(TEST_COMBINE) || defined(d_mm_rtt_fold_assigned_ns))
         HOST_REALM_TEST(memory_management, memory_management, mm_rtt_fold_assigned_ns),
         #endif
+        #if (defined(TEST_COMBINE) || defined(d_mm_libc_paths))
+        HOST_TEST(memory_management, memory_management, mm_libc_paths),
+        #endif
 
     #endif /* #if (defined(d_all) || defined(d_memory_management)) */
 #endif /* #if defined(RMM_V_1_0) */
@@ -841,6 +858,9 @@ DECLARE_TEST_FN(rhi_da_vdev_set_tdi_state);
 //        HOST_REALM_TEST(device_assignment, device_assignment,
 //                                            da_pdev_single_active_transaction),
 //        #endif
+        #if (defined(TEST_COMBINE) || defined(d_da_pdevs_interleaved_communicate))
+        HOST_TEST(device_assignment, device_assignment, da_pdevs_interleaved_communicate),
+        #endif
         #if (defined(TEST_COMBINE) || defined(d_mm_hipas_assigned_dev_ripas_empty_da_ia))
         HOST_REALM_TEST(device_assignment, device_assignment,
                             mm_hipas_assigned_dev_ripas_empty_da_ia),
@@ -863,6 +883,9 @@ DECLARE_TEST_FN(rhi_da_vdev_set_tdi_state);
         #if (defined(TEST_COMBINE) || defined(d_rhi_session_open))
         HOST_REALM_TEST(rhi, rhi, rhi_session_open),
         #endif
+        #if (defined(TEST_COMBINE) || defined(d_rhi_session_multi_rec))
+        HOST_REALM_TEST(rhi, rhi, rhi_session_multi_rec),
+        #endif
         #if (defined(TEST_COMBINE) || defined(d_rhi_session_close))
         HOST_REALM_TEST(rhi, rhi, rhi_session_close),
         #endif
@@ -887,6 +910,9 @@ DECLARE_TEST_FN(rhi_da_vdev_set_tdi_state);
         #if (defined(TEST_COMBINE) || defined(d_rhi_fal_read))
         HOST_REALM_TEST(rhi, rhi, rhi_fal_read),
         #endif
+        #if (defined(TEST_COMBINE) || defined(d_rhi_fal_stream_read))
+        HOST_REALM_TEST(rhi, rhi, rhi_fal_stream_read),
+        #endif
         #if (defined(TEST_COMBINE) || defined(d_rhi_fal_get_size))
         HOST_REALM_TEST(rhi, rhi, rhi_fal_get_size),
         #endif
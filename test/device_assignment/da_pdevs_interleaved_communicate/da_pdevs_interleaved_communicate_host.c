@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "command_common_host.h"
+#include "val_host_pcie.h"
+#include "val_host_helpers.h"
+#include "val_host_alloc.h"
+#include "val_host_da.h"
+
+#define MAX_PDEVS 4
+
+static val_host_pdev_ts pdev_devs[MAX_PDEVS];
+
+static uint32_t pdev_prepare(val_host_pdev_ts *pdev_dev, uint32_t *num_bdf)
+{
+    uint32_t rp_bdf;
+    val_host_pdev_flags_ts pdev_flags;
+
+    val_memset(pdev_dev, 0, sizeof(*pdev_dev));
+    val_memset(&pdev_flags, 0, sizeof(pdev_flags));
+
+    if (val_pcie_find_doe_capability(num_bdf, &pdev_dev->bdf, &pdev_dev->doe_cap_base))
+        return VAL_ERROR;
+
+    if (val_pcie_get_rootport(pdev_dev->bdf, &rp_bdf))
+        return VAL_ERROR;
+
+    pdev_dev->root_id = (uint16_t)rp_bdf;
+    val_host_set_pdev_flags(&pdev_flags);
+    val_memcpy(&pdev_dev->pdev_flags, &pdev_flags, sizeof(pdev_flags));
+
+    pdev_dev->pdev = g_pdev_new_prep_sequence(pdev_dev);
+    if (pdev_dev->pdev == VAL_TEST_PREP_SEQ_FAILED)
+    {
+        pdev_dev->pdev = 0;
+        return VAL_ERROR;
+    }
+
+    /* Allocate buffer to cache device certificate */
+    pdev_dev->cert_slot_id = 0;
+    pdev_dev->cert_chain = val_host_mem_alloc(PAGE_SIZE, VAL_HOST_PDEV_CERT_LEN_MAX);
+    pdev_dev->cert_chain_len = 0;
+    if (pdev_dev->cert_chain == NULL)
+        return VAL_ERROR;
+
+    return VAL_SUCCESS;
+}
+
+void da_pdevs_interleaved_communicate_host(void)
+{
+    val_host_pdev_ts *pdev_objs[MAX_PDEVS];
+    val_smc_param_ts args;
+    uint64_t feature_reg;
+    uint32_t num_bdf, count = 0, i;
+
+    /* Read Feature Register 0 and check for DA support */
+    val_host_rmi_features(0, &feature_reg);
+    if (VAL_EXTRACT_BITS(feature_reg, 42, 42) == 0) {
+        LOG(ERROR, "DA feature not supported.\n");
+        val_set_status(RESULT_SKIP(VAL_SKIP_CHECK));
+        goto exit;
+    }
+
+    num_bdf = val_pcie_get_num_bdf();
+    if (num_bdf == VAL_ERROR)
+    {
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto exit;
+    }
+
+    /* Create a PDEV for each DOE capable device, up to MAX_PDEVS */
+    while ((count < MAX_PDEVS) && (num_bdf != 0))
+    {
+        if (pdev_prepare(&pdev_devs[count], &num_bdf))
+        {
+            if (pdev_devs[count].pdev != 0)
+            {
+                LOG(ERROR, "PDEV preparation failed for bdf 0x%x\n", pdev_devs[count].bdf);
+                count++;
+                val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+                goto destroy_pdevs;
+            }
+            continue;
+        }
+
+        pdev_objs[count] = &pdev_devs[count];
+        count++;
+    }
+
+    if (count == 0)
+    {
+        LOG(ERROR, "No DOE capable device found\n");
+        val_set_status(RESULT_SKIP(VAL_SKIP_CHECK));
+        goto exit;
+    }
+
+    LOG(TEST, "\tInterleaving SPDM exchanges of %u PDEVs\n", count);
+
+    /* Drive all PDEVs to PDEV_NEEDS_KEY together */
+    if (val_host_pdevs_communicate(pdev_objs, count, RMI_PDEV_NEEDS_KEY))
+    {
+        LOG(ERROR, "Interleaved PDEV communicate failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+        goto destroy_pdevs;
+    }
+
+    /* Every PDEV must have settled in its own target state with its own certificate */
+    for (i = 0; i < count; i++)
+    {
+        args = val_host_rmi_pdev_get_state(pdev_devs[i].pdev);
+        if (args.x0 || (args.x1 != RMI_PDEV_NEEDS_KEY))
+        {
+            LOG(ERROR, "PDEV 0x%x state mismatch, ret=0x%lx state=0x%lx\n",
+                pdev_devs[i].bdf, args.x0, args.x1);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(4)));
+            goto destroy_pdevs;
+        }
+
+        if (pdev_devs[i].cert_chain_len == 0)
+        {
+            LOG(ERROR, "PDEV 0x%x certificate chain was not cached\n", pdev_devs[i].bdf);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(5)));
+            goto destroy_pdevs;
+        }
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+destroy_pdevs:
+    for (i = 0; i < count; i++)
+    {
+        if (val_host_pdev_teardown(&pdev_devs[i], pdev_devs[i].pdev))
+        {
+            LOG(ERROR, "PDEV teardown failed for bdf 0x%x\n", pdev_devs[i].bdf);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(6)));
+        }
+    }
+
+exit:
+    return;
+}
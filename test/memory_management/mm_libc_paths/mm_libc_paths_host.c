@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_timer.h"
+
+/* Alignments tried on each side, a whole doubleword and then some */
+#define LIBC_MAX_OFFSET     16U
+/* Guard bytes checked after each destination, to catch overruns */
+#define LIBC_GUARD          16U
+#define LIBC_GUARD_BYTE     0xA5U
+/* Buffer timed by the benchmark */
+#define LIBC_BENCH_SIZE     0x10000U
+/* Stop each benchmark run after this many calls or a tenth of a second */
+#define LIBC_BENCH_MAX_ITER 1024U
+
+static uint8_t src_buf[LIBC_BENCH_SIZE + LIBC_MAX_OFFSET];
+static uint8_t dst_buf[LIBC_BENCH_SIZE + LIBC_MAX_OFFSET + LIBC_GUARD];
+static uint8_t ref_buf[LIBC_BENCH_SIZE + LIBC_MAX_OFFSET + LIBC_GUARD];
+
+/* Byte at a time references, volatile so they are never turned into libc calls */
+static void byte_copy(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    volatile uint8_t *d = dst;
+    const volatile uint8_t *s = src;
+
+    while (len--)
+        *d++ = *s++;
+}
+
+static void byte_set(uint8_t *dst, uint8_t val, size_t len)
+{
+    volatile uint8_t *d = dst;
+
+    while (len--)
+        *d++ = val;
+}
+
+static int byte_cmp(const uint8_t *s1, const uint8_t *s2, size_t len)
+{
+    const volatile uint8_t *a = s1;
+    const volatile uint8_t *b = s2;
+
+    for (; len != 0; len--, a++, b++)
+    {
+        if (*a != *b)
+            return (*a < *b) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+static int sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+static const size_t long_len[] = {127, 128, 129, 255, 1000, 4095};
+
+#define LIBC_NUM_LEN        (18U + 19U + ARRAY_SIZE(long_len))
+
+/* Lengths at the word loop edges and on both sides of the MOPS threshold */
+static size_t test_len(uint32_t i)
+{
+    if (i < 18U)
+        return i;
+
+    if (i < 37U)
+        return PAL_MOPS_MIN_LEN - 9U + (i - 18U);
+
+    return long_len[i - 37U];
+}
+
+static uint32_t check_copy_set(void)
+{
+    uint32_t so, d, i;
+    size_t len;
+
+    for (i = 0; i < LIBC_NUM_LEN; i++)
+    {
+        len = test_len(i);
+        for (so = 0; so < LIBC_MAX_OFFSET; so++)
+        {
+            for (d = 0; d < LIBC_MAX_OFFSET; d++)
+            {
+                byte_set(dst_buf, LIBC_GUARD_BYTE, len + LIBC_MAX_OFFSET + LIBC_GUARD);
+                byte_set(ref_buf, LIBC_GUARD_BYTE, len + LIBC_MAX_OFFSET + LIBC_GUARD);
+
+                val_memcpy(dst_buf + d, src_buf + so, len);
+                byte_copy(ref_buf + d, src_buf + so, len);
+                if (byte_cmp(dst_buf, ref_buf, len + LIBC_MAX_OFFSET + LIBC_GUARD))
+                {
+                    LOG(ERROR, "memcpy mismatch len 0x%lx src +%d dst +%d\n", len, so, d);
+                    return VAL_ERROR;
+                }
+
+                /* so doubles as the fill value */
+                val_memset(dst_buf + d, (int)so, len);
+                byte_set(ref_buf + d, (uint8_t)so, len);
+                if (byte_cmp(dst_buf, ref_buf, len + LIBC_MAX_OFFSET + LIBC_GUARD))
+                {
+                    LOG(ERROR, "memset mismatch len 0x%lx dst +%d\n", len, d);
+                    return VAL_ERROR;
+                }
+            }
+        }
+    }
+
+    return VAL_SUCCESS;
+}
+
+static uint32_t check_cmp(void)
+{
+    uint32_t so, d, i, p;
+    size_t len, pos;
+
+    for (i = 1; i < LIBC_NUM_LEN; i++)
+    {
+        len = test_len(i);
+        for (so = 0; so < LIBC_MAX_OFFSET; so++)
+        {
+            for (d = 0; d < LIBC_MAX_OFFSET; d++)
+            {
+                byte_copy(dst_buf + d, src_buf + so, len);
+                if (val_memcmp(dst_buf + d, src_buf + so, len) != 0)
+                {
+                    LOG(ERROR, "memcmp of equal buffers len 0x%lx src +%d dst +%d\n",
+                        len, so, d);
+                    return VAL_ERROR;
+                }
+
+                /* A difference at the start, the middle and the last byte */
+                for (p = 0; p < 3U; p++)
+                {
+                    pos = (p == 0U) ? 0 : (p == 1U) ? (len / 2U) : (len - 1U);
+                    dst_buf[d + pos] ^= (uint8_t)(1U << (pos % 8U));
+                    if (sign(val_memcmp(dst_buf + d, src_buf + so, len)) !=
+                        byte_cmp(dst_buf + d, src_buf + so, len))
+                    {
+                        LOG(ERROR, "memcmp sign mismatch len 0x%lx pos 0x%lx\n", len, pos);
+                        return VAL_ERROR;
+                    }
+                    dst_buf[d + pos] ^= (uint8_t)(1U << (pos % 8U));
+                }
+            }
+        }
+    }
+
+    return VAL_SUCCESS;
+}
+
+static uint64_t kb_per_s(uint64_t bytes, uint64_t elapsed)
+{
+    if (elapsed == 0)
+        elapsed = 1;
+
+    return (bytes * val_read_cntfrq_el0()) / (elapsed * 1024U);
+}
+
+#define LIBC_BENCH(name, call)                                                     \
+    do {                                                                           \
+        uint64_t start = val_read_cntpct_el0(), elapsed = 0, count;               \
+        for (count = 0; (count < LIBC_BENCH_MAX_ITER) && (elapsed < limit); count++) \
+        {                                                                          \
+            call;                                                                  \
+            elapsed = val_read_cntpct_el0() - start;                               \
+        }                                                                          \
+        LOG(ALWAYS, "%s 0x%lx bytes: %lu KB/s\n", name, size,                      \
+            kb_per_s(count * size, elapsed));                                      \
+    } while (0)
+
+static void bench(void)
+{
+    static const size_t sizes[] = {PAL_MOPS_MIN_LEN, 0x1000, LIBC_BENCH_SIZE};
+    uint64_t limit = val_read_cntfrq_el0() / 10U;
+    uint32_t i;
+    size_t size;
+
+    for (i = 0; i < ARRAY_SIZE(sizes); i++)
+    {
+        size = sizes[i];
+        LIBC_BENCH("memcpy     ", val_memcpy(dst_buf, src_buf, size));
+        LIBC_BENCH("byte copy  ", byte_copy(ref_buf, src_buf, size));
+        LIBC_BENCH("memset     ", val_memset(dst_buf, 0x5A, size));
+        LIBC_BENCH("byte set   ", byte_set(ref_buf, 0x5A, size));
+        byte_copy(dst_buf, src_buf, size);
+        LIBC_BENCH("memcmp     ", (void)val_memcmp(dst_buf, src_buf, size));
+        LIBC_BENCH("byte cmp   ", (void)byte_cmp(dst_buf, src_buf, size));
+    }
+}
+
+void mm_libc_paths_host(void)
+{
+    uint64_t seed = 0x2545f4914f6cdd1dULL;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(src_buf); i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        src_buf[i] = (uint8_t)seed;
+    }
+
+    /* Below PAL_MOPS_MIN_LEN the word loops run, from it on MOPS where the PE has it */
+    if (check_copy_set())
+    {
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto exit;
+    }
+
+    if (check_cmp())
+    {
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto exit;
+    }
+
+    bench();
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+exit:
+    return;
+}
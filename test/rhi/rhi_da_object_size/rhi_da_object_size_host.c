@@ -144,7 +144,9 @@ destroy_device:
         goto destroy_realm;
     }
 
-    if (val_host_pdev_teardown(&pdev_obj, pdev_obj.pdev))
+    /* A PDEV shared across rhi tests is left to da_release_shared_pdev() */
+    if (!da_pdev_is_shared(pdev_obj.pdev) &&
+        val_host_pdev_teardown(&pdev_obj, pdev_obj.pdev))
     {
         val_set_status(RESULT_FAIL(VAL_ERROR_POINT(18)));
         goto destroy_realm;
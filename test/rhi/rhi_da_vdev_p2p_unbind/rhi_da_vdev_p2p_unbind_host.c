@@ -123,7 +123,9 @@ destroy_vdev1:
         val_set_status(RESULT_FAIL(VAL_ERROR_POINT(9)));
     }
 
-    if (val_host_pdev_teardown(&pdev_obj, pdev_obj.pdev))
+    /* A PDEV shared across rhi tests is left to da_release_shared_pdev() */
+    if (!da_pdev_is_shared(pdev_obj.pdev) &&
+        val_host_pdev_teardown(&pdev_obj, pdev_obj.pdev))
     {
         LOG(ERROR, "PDEV teardown failed\n");
         val_set_status(RESULT_FAIL(VAL_ERROR_POINT(10)));
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_host_rhi.h"
+
+/* One page window, its ring is smaller than the log so the host has to refill it */
+#define FAL_WINDOW_SIZE     PAGE_SIZE
+
+/* Upper bound of RHI_FAL_READ exits needed to drain the log through the window */
+#define FAL_MAX_READS       ((RHI_FAL_LOG_SIZE / (FAL_WINDOW_SIZE - RHI_FAL_WINDOW_DATA_OFFSET)) + 2)
+
+void rhi_fal_stream_read_host(void)
+{
+    val_host_realm_ts realm;
+    val_host_rec_enter_ts *rec_enter = NULL;
+    uint64_t ret;
+    uint32_t index, step;
+
+    val_memset(&realm, 0, sizeof(realm));
+
+    val_host_realm_params(&realm);
+
+    /* Populate realm with one REC */
+    if (val_host_realm_setup(&realm, true))
+    {
+        LOG(ERROR, "Realm setup failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto destroy_realm;
+    }
+
+    ret = val_host_rmi_rec_enter(realm.rec[0], realm.run[0]);
+    if (ret)
+    {
+        LOG(ERROR, "REC enter failed, ret=%lx\n", ret);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto destroy_realm;
+    } else if (val_host_check_realm_exit_host_call((val_host_rec_run_ts *)realm.run[0]))
+    {
+        LOG(ERROR, "REC_EXIT: HOST_CALL params mismatch\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+        goto destroy_realm;
+    }
+
+    index = val_host_rhi_fal_stream_init(&realm, FAL_WINDOW_SIZE);
+    if (!index)
+    {
+        LOG(ERROR, "FAL window setup failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(4)));
+        goto destroy_realm;
+    }
+
+    /* Pass the window to the Realm */
+    rec_enter = &(((val_host_rec_run_ts *)realm.run[0])->enter);
+    rec_enter->gprs[1] = realm.granules[index].ipa;
+    rec_enter->gprs[2] = realm.granules[index].size;
+
+    /* Serve RHI_FAL_READ until the Realm reports back */
+    for (step = 0; step < FAL_MAX_READS; step++)
+    {
+        ret = val_host_rmi_rec_enter(realm.rec[0], realm.run[0]);
+        if (ret)
+        {
+            LOG(ERROR, "REC enter failed, ret=%lx\n", ret);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(5)));
+            goto destroy_realm;
+        }
+
+        if (!val_host_check_realm_exit_host_call((val_host_rec_run_ts *)realm.run[0]))
+            break;
+
+        if (val_host_check_realm_exit_rsi_host_call((val_host_rec_run_ts *)realm.run[0]))
+        {
+            LOG(ERROR, "REC_EXIT: HOST_CALL params mismatch\n");
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(6)));
+            goto destroy_realm;
+        }
+
+        ret = val_host_rhi_dispatch(&realm);
+        if (ret)
+        {
+            LOG(ERROR, "RHI command failed, ret=%lx\n", ret);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(7)));
+            goto destroy_realm;
+        }
+    }
+
+    if (step == FAL_MAX_READS)
+    {
+        LOG(ERROR, "FAL log not drained after %d reads\n", step);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(8)));
+        goto destroy_realm;
+    }
+
+    /* The Realm needs more than one window fill to drain the log */
+    if (step < 2)
+    {
+        LOG(ERROR, "FAL log drained in %d reads\n", step);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(9)));
+        goto destroy_realm;
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+    /* Free test resources */
+destroy_realm:
+    return;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "test_database.h"
+#include "val_realm_rsi.h"
+#include "val_rhi.h"
+#include "val_realm_framework.h"
+#include "val_realm_memory.h"
+
+#define FAL_PATTERN 0xabcdabcdU
+
+/* Both are as large as the log, keep them off the Realm stack */
+static uint8_t expected[RHI_FAL_LOG_SIZE];
+static uint8_t fal_log[RHI_FAL_LOG_SIZE];
+
+static void build_expected(uint8_t *buffer, uint64_t length)
+{
+    uint64_t idx;
+    uint32_t pattern = FAL_PATTERN;
+
+    for (idx = 0; idx < length; idx++)
+    {
+        buffer[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
+    }
+}
+
+void rhi_fal_stream_read_realm(void)
+{
+    val_realm_rsi_host_call_t *gv_realm_host_call;
+    val_memory_region_descriptor_ts mem_desc;
+    uint64_t window_ipa, window_size, len = 0;
+    uint64_t ret;
+
+    /* Get the FAL window set up by the host */
+    gv_realm_host_call = val_realm_rsi_host_call_ripas(VAL_SWITCH_TO_HOST);
+    window_ipa = gv_realm_host_call->gprs[1];
+    window_size = gv_realm_host_call->gprs[2];
+
+    mem_desc.virtual_address = window_ipa;
+    mem_desc.physical_address = window_ipa;
+    mem_desc.length = window_size;
+    mem_desc.attributes = MT_RW_DATA | MT_NS;
+    if (val_realm_pgt_create(&mem_desc))
+    {
+        LOG(ERROR, "VA to PA mapping failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto exit;
+    }
+
+    LOG(TEST, "RHI_FAL_READ through a window smaller than the log\n");
+    ret = val_realm_rhi_fal_stream_read(window_ipa, fal_log, sizeof(fal_log), &len);
+    if (ret != RHI_FAL_SUCCESS)
+    {
+        LOG(ERROR, "FAL stream read failed: %lx\n", ret);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto exit;
+    }
+
+    if (len != RHI_FAL_LOG_SIZE)
+    {
+        LOG(ERROR, "FAL stream read returned %lx bytes\n", len);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+        goto exit;
+    }
+
+    build_expected(expected, RHI_FAL_LOG_SIZE);
+    if (val_memcmp(fal_log, expected, RHI_FAL_LOG_SIZE))
+    {
+        LOG(ERROR, "FAL stream data mismatch\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(4)));
+        goto exit;
+    }
+
+exit:
+    val_realm_return_to_host();
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_host_rhi.h"
+
+/* Enter REC[rec_idx], serving its RHI calls until it exits for another reason */
+static uint64_t run_rec(val_host_realm_ts *realm, uint64_t rec_idx)
+{
+    uint64_t ret;
+
+    while (1)
+    {
+        ret = val_host_rmi_rec_enter(realm->rec[rec_idx], realm->run[rec_idx]);
+        if (ret)
+        {
+            LOG(ERROR, "REC[%lu] enter failed, ret=%lx\n", rec_idx, ret);
+            return VAL_ERROR;
+        }
+
+        if (val_host_check_realm_exit_rsi_host_call((val_host_rec_run_ts *)realm->run[rec_idx]))
+            return VAL_SUCCESS;
+
+        /* Results go back to the REC which made the call */
+        ret = val_host_rhi_dispatch_rec(realm, rec_idx);
+        if (ret)
+        {
+            LOG(ERROR, "RHI command of REC[%lu] failed, ret=%lx\n", rec_idx, ret);
+            return VAL_ERROR;
+        }
+    }
+}
+
+void rhi_session_multi_rec_host(void)
+{
+    val_host_realm_ts realm;
+    uint64_t ret;
+
+    val_memset(&realm, 0, sizeof(realm));
+
+    val_host_realm_params(&realm);
+
+    realm.rec_count = 2;
+
+    /* Populate realm with two RECs */
+    if (val_host_realm_setup(&realm, true))
+    {
+        LOG(ERROR, "Realm setup failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto destroy_realm;
+    }
+
+    /* REC[0] powers on REC[1] */
+    if (run_rec(&realm, 0) ||
+        val_host_check_realm_exit_psci((val_host_rec_run_ts *)realm.run[0], PSCI_CPU_ON_AARCH64))
+    {
+        LOG(ERROR, "REC_EXIT: PSCI_CPU_ON params mismatch\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto destroy_realm;
+    }
+
+    ret = val_host_rmi_psci_complete(realm.rec[0], realm.rec[1], PSCI_E_SUCCESS);
+    if (ret)
+    {
+        LOG(ERROR, "PSCI complete failed, ret=%lx\n", ret);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+        goto destroy_realm;
+    }
+
+    /* REC[0] opens a session and hands over to the host with it still open */
+    if (run_rec(&realm, 0) ||
+        val_host_check_realm_exit_host_call((val_host_rec_run_ts *)realm.run[0]))
+    {
+        LOG(ERROR, "REC_EXIT: HOST_CALL params mismatch\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(4)));
+        goto destroy_realm;
+    }
+
+    /* REC[1] opens and closes its own session, then powers off */
+    if (run_rec(&realm, 1) ||
+        val_host_check_realm_exit_psci((val_host_rec_run_ts *)realm.run[1], PSCI_CPU_OFF))
+    {
+        LOG(ERROR, "REC_EXIT: PSCI_CPU_OFF params mismatch\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(5)));
+        goto destroy_realm;
+    }
+
+    /* REC[0] closes its session and reports the result */
+    if (run_rec(&realm, 0) ||
+        val_host_check_realm_exit_host_call((val_host_rec_run_ts *)realm.run[0]))
+    {
+        LOG(ERROR, "REC_EXIT: HOST_CALL params mismatch\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(6)));
+        goto destroy_realm;
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+    /* Free test resources */
+destroy_realm:
+    return;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "test_database.h"
+#include "val_realm_rsi.h"
+#include "val_rhi.h"
+#include "val_realm_framework.h"
+
+#define CONTEXT_ID 0x5555
+
+/* Session opened by each REC, written by the REC which owns the slot */
+static volatile uint64_t g_session_id[2];
+static volatile uint64_t g_rec1_status;
+
+static uint64_t session_open(uint64_t *sess_id)
+{
+    __attribute__((aligned (PAGE_SIZE))) val_realm_rsi_host_call_t rhi_call = {0};
+
+    rhi_call.imm = 0;
+    rhi_call.gprs[0] = RHI_SESSION_OPEN;
+    rhi_call.gprs[1] = 0;
+    rhi_call.gprs[2] = RHI_CONN_MODE_BLOCKING;
+    if (val_realm_rsi_rhi_host(&rhi_call))
+        return VAL_ERROR;
+
+    if ((rhi_call.gprs[0] != RHI_SESS_SUCCESS) ||
+        (rhi_call.gprs[2] != RHI_HSS_CONNECTION_ESTABLISHED) || (rhi_call.gprs[1] == 0))
+    {
+        LOG(ERROR, "RHI_SESSION_OPEN failed err: %lx state %lx\n",
+                                            rhi_call.gprs[0], rhi_call.gprs[2]);
+        return VAL_ERROR;
+    }
+
+    *sess_id = rhi_call.gprs[1];
+    return VAL_SUCCESS;
+}
+
+static uint64_t session_close(uint64_t sess_id, uint64_t expected)
+{
+    __attribute__((aligned (PAGE_SIZE))) val_realm_rsi_host_call_t rhi_call = {0};
+
+    rhi_call.imm = 0;
+    rhi_call.gprs[0] = RHI_SESSION_CLOSE;
+    rhi_call.gprs[1] = sess_id;
+    if (val_realm_rsi_rhi_host(&rhi_call))
+        return VAL_ERROR;
+
+    if (rhi_call.gprs[0] != expected)
+    {
+        LOG(ERROR, "RHI_SESSION_CLOSE err: %lx expected: %lx\n", rhi_call.gprs[0], expected);
+        return VAL_ERROR;
+    }
+
+    return VAL_SUCCESS;
+}
+
+static void secondary_cpu(void)
+{
+    uint64_t sess_id = 0;
+
+    /* REC[1] opens its own session while REC[0] still holds one */
+    if (session_open(&sess_id))
+    {
+        g_rec1_status = RESULT_FAIL(VAL_ERROR_POINT(1));
+        goto exit;
+    }
+
+    g_session_id[1] = sess_id;
+    if (sess_id == g_session_id[0])
+    {
+        LOG(ERROR, "REC[1] got the session id of REC[0]: %lx\n", sess_id);
+        g_rec1_status = RESULT_FAIL(VAL_ERROR_POINT(2));
+        goto exit;
+    }
+
+    if (session_close(sess_id, RHI_SESS_SUCCESS))
+    {
+        g_rec1_status = RESULT_FAIL(VAL_ERROR_POINT(3));
+        goto exit;
+    }
+
+    g_rec1_status = RESULT_PASS(VAL_SUCCESS);
+
+exit:
+    val_psci_cpu_off();
+}
+
+void rhi_session_multi_rec_realm(void)
+{
+    uint64_t sess_id = 0;
+
+    if (val_get_primary_mpidr() != val_read_mpidr())
+        secondary_cpu();
+
+    g_rec1_status = RESULT_FAIL(VAL_ERROR_POINT(4));
+
+    /* Power on REC[1] execution */
+    if (val_psci_cpu_on(REC_NUM(1), val_realm_get_secondary_cpu_entry(), CONTEXT_ID))
+    {
+        LOG(ERROR, "PSCI CPU ON failed\n");
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(5)));
+        goto exit;
+    }
+
+    if (session_open(&sess_id))
+    {
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(6)));
+        goto exit;
+    }
+
+    g_session_id[0] = sess_id;
+
+    /* Let the host run REC[1] while this session stays open */
+    val_realm_rsi_host_call_ripas(VAL_SWITCH_TO_HOST);
+
+    if (g_rec1_status != RESULT_PASS(VAL_SUCCESS))
+    {
+        val_set_status(g_rec1_status);
+        goto exit;
+    }
+
+    /* The session of REC[0] must have survived REC[1] closing its own */
+    if (session_close(sess_id, RHI_SESS_SUCCESS))
+    {
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(7)));
+        goto exit;
+    }
+
+    /* REC[1] closed its session already */
+    if (session_close(g_session_id[1], RHI_SESS_INVALID_SESSION_ID))
+    {
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(8)));
+        goto exit;
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+exit:
+    val_realm_return_to_host();
+}
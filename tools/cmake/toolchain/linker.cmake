@@ -78,6 +78,7 @@ function (create_executable EXE_NAME OUTPUT_DIR TEST)
                     ${BUILD}/external/mbedtls/build/library/mbedtls.a
                     ${BUILD}/external/mbedtls/build/library/mbedx509.a
                     ${BUILD}/external/mbedtls/build/library/mbedcrypto.a
+                    ${PAL_LIB}.a
                     DEPENDS CPP-LD-${EXE_NAME}${TEST})
     add_custom_target(${EXE_NAME}${TEST}_elf ALL DEPENDS ${EXE_NAME}${TEST}.elf)
 
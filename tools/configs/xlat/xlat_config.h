@@ -8,3 +8,10 @@
 #define PLAT_ASSERT_FUNC val_assert
 #define PLAT_PRINT_FUNC val_printf
 #define PLAT_REALM_PRINT_FUNC val_realm_printf
+
+/*
+ * Translation tables, the base tables and the per-table region counters of
+ * every ACS image live in the BSS, which the boot code clears before
+ * init_xlat_tables_ctx() runs, so the library does not need to zero them.
+ */
+#define PLAT_XLAT_TABLES_PREZEROED 1
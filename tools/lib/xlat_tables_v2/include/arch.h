@@ -717,6 +717,18 @@
 #define TLBI_ADDR_MASK        ULL(0x00000FFFFFFFFFFF)
 #define TLBI_ADDR(x)        (((x) >> TLBI_ADDR_SHIFT) & TLBI_ADDR_MASK)
 
+/* Operand of the FEAT_TLBIRANGE TLBI R* instructions, 4KB granule */
+#define TLBI_RANGE_TG_4K        ULL(1)
+#define TLBI_RANGE_TG_SHIFT        U(46)
+#define TLBI_RANGE_SCALE_SHIFT        U(44)
+#define TLBI_RANGE_SCALE_MAX        U(3)
+#define TLBI_RANGE_NUM_SHIFT        U(39)
+#define TLBI_RANGE_NUM_MAX        U(31)
+#define TLBI_RANGE_BADDR_MASK        ULL(0x1FFFFFFFFF)
+/* Number of pages invalidated by one range operation */
+#define TLBI_RANGE_PAGES(num, scale)    \
+    ((uint64_t)((num) + 1U) << ((5U * (scale)) + 1U))
+
 
 /*******************************************************************************
  * Definitions for system register interface to SVE
@@ -891,6 +903,11 @@
 #define ID_AA64ISAR0_EL1_RNDR_SHIFT        UL(60)
 #define ID_AA64ISAR0_EL1_RNDR_WIDTH        UL(4)
 
+/* TLB maintenance definitions */
+#define ID_AA64ISAR0_EL1_TLB_SHIFT        UL(56)
+#define ID_AA64ISAR0_EL1_TLB_WIDTH        UL(4)
+#define ID_AA64ISAR0_EL1_TLB_RANGE        UL(2)
+
 /* ID_AA64MMFR1_EL1 definitions */
 #define ID_AA64MMFR1_EL1_VMIDBits_SHIFT        UL(4)
 #define ID_AA64MMFR1_EL1_VMIDBits_WIDTH        UL(4)
@@ -64,6 +64,17 @@ static inline bool is_feat_rng_present(void)
         read_id_aa64isar0_el1()) != 0UL);
 }
 
+/*
+ * Check if FEAT_TLBIRANGE is implemented
+ * ID_AA64ISAR0_EL1.TLB, bits [59:56]:
+ * 0b0010 Outer Shareable and TLB range maintenance instructions implemented.
+ */
+static inline bool is_feat_tlbirange_present(void)
+{
+    return (EXTRACT(ID_AA64ISAR0_EL1_TLB,
+        read_id_aa64isar0_el1()) == ID_AA64ISAR0_EL1_TLB_RANGE);
+}
+
 /*
  * Check if FEAT_VMID16 is implemented
  * ID_AA64MMFR1_EL1.VMIDBits, bits [7:4]:
@@ -38,6 +38,13 @@
 #define MT_STATIC    (U(0) << MT_DYN_SHIFT)
 #define MT_DYNAMIC    (U(1) << MT_DYN_SHIFT)
 
+/*
+ * Split the block descriptor at 'entry' into a subtable of the next level with
+ * the same attributes. Returns the subtable or NULL if no table is free.
+ */
+uint64_t *xlat_table_split_block(const xlat_ctx_t *ctx, uint64_t *entry,
+                 unsigned int level, uintptr_t block_va);
+
 #endif /* PLAT_XLAT_TABLES_DYNAMIC */
 
 extern uint64_t mmu_cfg_params[MMU_CFG_PARAM_MAX];
@@ -64,6 +71,28 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime);
  */
 void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime);
 
+/*
+ * Above this number of pages a range of TLB entries is invalidated by dropping
+ * all the entries of the translation regime instead.
+ */
+#ifndef XLAT_TLBI_ALL_THRESHOLD
+#define XLAT_TLBI_ALL_THRESHOLD        U(512)
+#endif
+
+/*
+ * Invalidate all TLB entries of the given translation regime for the PEs in the
+ * Inner Shareable domain.
+ */
+void xlat_arch_tlbi_all(int xlat_regime);
+
+/*
+ * Invalidate the TLB entries of 'size' bytes of virtual address space starting
+ * at 'va'. Range TLBI instructions are used when FEAT_TLBIRANGE is implemented,
+ * and the whole regime is invalidated above XLAT_TLBI_ALL_THRESHOLD pages. As
+ * with xlat_arch_tlbi_va(), xlat_arch_tlbi_va_sync() must be called afterwards.
+ */
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime);
+
 /*
  * This function has to be called at the end of any code that uses the function
  * xlat_arch_tlbi_va().
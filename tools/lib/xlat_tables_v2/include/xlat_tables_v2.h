@@ -384,6 +384,10 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx,
  * NOTE2: The caller is responsible for making sure that the targeted
  * translation tables are not modified by any other code while this function is
  * executing.
+ *
+ * NOTE3: The pages are remapped in runs of up to one last level table. All the
+ * pages of a run are unmapped at the same time during its break-before-make
+ * sequence, so the region must not be accessed by other PEs meanwhile.
  */
 int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
                    size_t size, uint32_t attr);
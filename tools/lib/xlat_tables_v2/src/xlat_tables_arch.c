@@ -178,14 +178,9 @@ uint64_t xlat_arch_regime_get_xn_desc(int xlat_regime)
     }
 }
 
-void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+/* Issue the TLBI by VA for one page, without any barrier. */
+static void xlat_arch_tlbi_page(uintptr_t va, int xlat_regime)
 {
-    /*
-     * Ensure the translation table write has drained into memory before
-     * invalidating the TLB entry.
-     */
-    dsbishst();
-
     /*
      * This function only supports invalidation of TLB entries for the EL3
      * and EL1&0 translation regimes.
@@ -206,6 +201,97 @@ void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
     }
 }
 
+/*
+ * Issue one FEAT_TLBIRANGE operation, without any barrier. The TLBI R* forms
+ * are written as SYS instructions so the assembler needs no Armv8.4 support.
+ */
+static void xlat_arch_tlbi_range_op(uint64_t arg, int xlat_regime)
+{
+    if (xlat_regime == EL1_EL0_REGIME) {
+        /* TLBI RVAAE1IS */
+        __asm__ volatile("sys #0, c8, c2, #3, %0" : : "r" (arg));
+    } else if (xlat_regime == EL2_REGIME) {
+        /* TLBI RVAE2IS */
+        __asm__ volatile("sys #4, c8, c2, #1, %0" : : "r" (arg));
+    } else {
+        /* TLBI RVAE3IS */
+        __asm__ volatile("sys #6, c8, c2, #1, %0" : : "r" (arg));
+    }
+}
+
+void xlat_arch_tlbi_va(uintptr_t va, int xlat_regime)
+{
+    /*
+     * Ensure the translation table write has drained into memory before
+     * invalidating the TLB entry.
+     */
+    dsbishst();
+
+    xlat_arch_tlbi_page(va, xlat_regime);
+}
+
+void xlat_arch_tlbi_all(int xlat_regime)
+{
+    dsbishst();
+
+    if (xlat_regime == EL1_EL0_REGIME) {
+        assert(xlat_arch_current_el() >= 1U);
+        tlbivmalle1is();
+    } else if (xlat_regime == EL2_REGIME) {
+        assert(xlat_arch_current_el() >= 2U);
+        tlbialle2is();
+    } else {
+        assert(xlat_regime == EL3_REGIME);
+        assert(xlat_arch_current_el() >= 3U);
+        tlbialle3is();
+    }
+}
+
+void xlat_arch_tlbi_va_range(uintptr_t va, size_t size, int xlat_regime)
+{
+    uint64_t pages = size >> PAGE_SIZE_SHIFT;
+    bool range = is_feat_tlbirange_present() &&
+                    (PAGE_SIZE_SHIFT == FOUR_KB_SHIFT);
+
+    if (pages > XLAT_TLBI_ALL_THRESHOLD) {
+        xlat_arch_tlbi_all(xlat_regime);
+        return;
+    }
+
+    /* All the table writes must be visible before any invalidation. */
+    dsbishst();
+
+    while (pages != 0U) {
+        unsigned int scale = TLBI_RANGE_SCALE_MAX;
+        uint64_t num;
+
+        /* Range operations cover an even number of pages. */
+        if (!range || ((pages & 1U) != 0U)) {
+            xlat_arch_tlbi_page(va, xlat_regime);
+            va += PAGE_SIZE;
+            pages--;
+            continue;
+        }
+
+        while (pages < TLBI_RANGE_PAGES(0U, scale))
+            scale--;
+
+        num = pages >> ((5U * scale) + 1U);
+        if (num > (TLBI_RANGE_NUM_MAX + 1U))
+            num = TLBI_RANGE_NUM_MAX + 1U;
+        num--;
+
+        xlat_arch_tlbi_range_op(
+            (TLBI_RANGE_TG_4K << TLBI_RANGE_TG_SHIFT) |
+            ((uint64_t)scale << TLBI_RANGE_SCALE_SHIFT) |
+            (num << TLBI_RANGE_NUM_SHIFT) |
+            (TLBI_ADDR(va) & TLBI_RANGE_BADDR_MASK), xlat_regime);
+
+        va += (uintptr_t)(TLBI_RANGE_PAGES(num, scale) << PAGE_SIZE_SHIFT);
+        pages -= TLBI_RANGE_PAGES(num, scale);
+    }
+}
+
 void xlat_arch_tlbi_va_sync(void)
 {
     /*
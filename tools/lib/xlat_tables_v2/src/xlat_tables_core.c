@@ -87,6 +87,58 @@ static bool xlat_table_is_empty(const xlat_ctx_t *ctx, const uint64_t *table)
     return ctx->tables_mapped_regions[xlat_table_get_index(ctx, table)] == 0;
 }
 
+/*
+ * Replaces the block descriptor at 'entry' (translation level 'level', mapping
+ * 'block_va') with a table descriptor pointing to a new subtable that maps the
+ * same memory with the same attributes at the next level. Large regions are
+ * mapped with blocks and only split when a sub-range needs its own attributes.
+ * Returns the subtable, or NULL if there is no empty table left.
+ */
+uint64_t *xlat_table_split_block(const xlat_ctx_t *ctx, uint64_t *entry,
+                 unsigned int level, uintptr_t block_va)
+{
+    uint64_t desc = *entry;
+    uint64_t attrs = desc & ~(TABLE_ADDR_MASK | DESC_MASK);
+    unsigned long long pa = desc & TABLE_ADDR_MASK;
+    uint64_t sub_type = ((level + 1U) == XLAT_TABLE_LEVEL_MAX) ?
+                                PAGE_DESC : BLOCK_DESC;
+    uint64_t *subtable;
+
+    assert((desc & DESC_MASK) == BLOCK_DESC);
+    assert(level < XLAT_TABLE_LEVEL_MAX);
+
+    subtable = xlat_table_get_empty(ctx);
+    if (subtable == NULL)
+        return NULL;
+
+    for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
+        subtable[i] = attrs | sub_type |
+            (pa + ((unsigned long long)i * XLAT_BLOCK_SIZE(level + 1U)));
+
+    /* The subtable belongs to the region that owned the block. */
+    xlat_table_inc_regions_count(ctx, subtable);
+#if !(HW_ASSISTED_COHERENCY || WARMBOOT_ENABLE_DCACHE_EARLY)
+    xlat_clean_dcache_range((uintptr_t)subtable,
+        XLAT_TABLE_ENTRIES * sizeof(uint64_t));
+#endif
+
+    /* Break-before-make, as when changing the attributes of a page. */
+    *entry = INVALID_DESC;
+#if !HW_ASSISTED_COHERENCY
+    dccvac((uintptr_t)entry);
+#endif
+    xlat_arch_tlbi_va(block_va, ctx->xlat_regime);
+    xlat_arch_tlbi_va_sync();
+
+    *entry = TABLE_DESC | (uintptr_t)subtable;
+#if !HW_ASSISTED_COHERENCY
+    dccvac((uintptr_t)entry);
+#endif
+    dsbish();
+
+    return subtable;
+}
+
 #else /* PLAT_XLAT_TABLES_DYNAMIC */
 
 /* Returns a pointer to the first empty translation table. */
@@ -389,7 +441,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
         if (action == ACTION_WRITE_BLOCK_ENTRY) {
 
             table_base[table_idx] = INVALID_DESC;
-            xlat_arch_tlbi_va(table_idx_va, ctx->xlat_regime);
 
         } else if (action == ACTION_RECURSE_INTO_TABLE) {
 
@@ -408,8 +459,6 @@ static void xlat_tables_unmap_region(xlat_ctx_t *ctx, mmap_region_t *mm,
              */
             if (xlat_table_is_empty(ctx, subtable)) {
                 table_base[table_idx] = INVALID_DESC;
-                xlat_arch_tlbi_va(table_idx_va,
-                          ctx->xlat_regime);
             }
 
         } else {
@@ -1120,6 +1169,11 @@ int mmap_remove_dynamic_region_ctx(xlat_ctx_t *ctx, uintptr_t base_va,
         xlat_clean_dcache_range((uintptr_t)ctx->base_table,
             ctx->base_table_entries * sizeof(uint64_t));
 #endif
+        /*
+         * The TLB entries of the whole region are invalidated at once here
+         * rather than entry by entry while unmapping it.
+         */
+        xlat_arch_tlbi_va_range(mm->base_va, mm->size, ctx->xlat_regime);
         xlat_arch_tlbi_va_sync();
     }
 
@@ -1200,7 +1254,11 @@ void init_xlat_tables_ctx(xlat_ctx_t *ctx)
     xlat_mmap_print(mm);
 
     /* All tables must be zeroed before mapping any region. */
-
+#if PLAT_XLAT_TABLES_PREZEROED
+#if INVALID_DESC != 0
+#error "PLAT_XLAT_TABLES_PREZEROED requires INVALID_DESC to be zero"
+#endif
+#else
     for (unsigned int i = 0U; i < ctx->base_table_entries; i++)
         ctx->base_table[i] = INVALID_DESC;
 
@@ -1211,6 +1269,7 @@ void init_xlat_tables_ctx(xlat_ctx_t *ctx)
         for (unsigned int i = 0U; i < XLAT_TABLE_ENTRIES; i++)
             ctx->tables[j][i] = INVALID_DESC;
     }
+#endif /* PLAT_XLAT_TABLES_PREZEROED */
 
     while (mm->size != 0U) {
         uintptr_t end_va = xlat_tables_map_region(ctx, mm, 0U,
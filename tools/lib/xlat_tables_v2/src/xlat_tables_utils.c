@@ -440,8 +440,6 @@ int xlat_get_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
 int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
                    size_t size, uint32_t attr)
 {
-    /* Note: This implementation isn't optimized. */
-
     assert(ctx != NULL);
     assert(ctx->initialized);
 
@@ -484,7 +482,7 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
      * Sanity checks.
      */
     for (unsigned int i = 0U; i < pages_count; ++i) {
-        const uint64_t *entry;
+        uint64_t *entry;
         uint64_t desc, attr_index;
         unsigned int level;
 
@@ -498,6 +496,25 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
             return -EINVAL;
         }
 
+#if PLAT_XLAT_TABLES_DYNAMIC
+        /* Split block mappings covering this page down to page granularity. */
+        while (((*entry & DESC_MASK) == BLOCK_DESC) &&
+               (level < XLAT_TABLE_LEVEL_MAX)) {
+            if (xlat_table_split_block(ctx, entry, level,
+                           base_va & ~XLAT_BLOCK_MASK(level)) == NULL) {
+                LOG(ERROR, "No free table to split the block at 0x%lx.\n",
+                     base_va);
+                return -ENOMEM;
+            }
+
+            entry = find_xlat_table_entry(base_va,
+                              ctx->base_table,
+                              ctx->base_table_entries,
+                              virt_addr_space_size,
+                              &level);
+        }
+#endif
+
         desc = *entry;
 
         /*
@@ -531,40 +548,53 @@ int xlat_change_mem_attributes_ctx(const xlat_ctx_t *ctx, uintptr_t base_va,
     /* Restore original value. */
     base_va = base_va_original;
 
-    for (unsigned int i = 0U; i < pages_count; ++i) {
+    /*
+     * The pages are updated in runs of contiguous descriptors, each run
+     * ending with the last level table that holds it. Each run goes through
+     * a single break-before-make sequence: all its descriptors are broken,
+     * the TLBs are invalidated for the whole run at once and the new
+     * descriptors are written after one DSB.
+     */
+    while (pages_count > 0U) {
 
-        uint32_t old_attr = 0U, new_attr;
+        uint32_t old_attr = 0U;
         uint64_t *entry = NULL;
         unsigned int level = 0U;
         unsigned long long addr_pa = 0ULL;
+        size_t run;
 
         (void) xlat_get_mem_attributes_internal(ctx, base_va, &old_attr,
                         &entry, &addr_pa, &level);
 
-        /* Ignore old attributes. Rewrite the descriptor with new attributs */
-                new_attr = attr;
+        run = XLAT_TABLE_ENTRIES - XLAT_TABLE_IDX(base_va, level);
+        if (run > pages_count)
+            run = pages_count;
 
         /*
-         * The break-before-make sequence requires writing an invalid
-         * descriptor and making sure that the system sees the change
-         * before writing the new descriptor.
+         * Break: only the valid bit is cleared so that the output address
+         * of each page can be read back when the new descriptor is written.
          */
-        *entry = INVALID_DESC;
+        for (size_t i = 0U; i < run; ++i)
+            entry[i] &= ~DESC_MASK;
 #if !HW_ASSISTED_COHERENCY
-        dccvac((uintptr_t)entry);
+        clean_dcache_range((uintptr_t)entry, run * sizeof(uint64_t));
 #endif
-        /* Invalidate any cached copy of this mapping in the TLBs. */
-        xlat_arch_tlbi_va(base_va, ctx->xlat_regime);
+        /* Invalidate any cached copy of the run in the TLBs. */
+        xlat_arch_tlbi_va_range(base_va, run * PAGE_SIZE, ctx->xlat_regime);
 
         /* Ensure completion of the invalidation. */
         xlat_arch_tlbi_va_sync();
 
-        /* Write new descriptor */
-        *entry = xlat_desc(ctx, new_attr, addr_pa, level);
+        /* Write new descriptors, ignoring the old attributes */
+        for (size_t i = 0U; i < run; ++i) {
+            addr_pa = entry[i] & TABLE_ADDR_MASK;
+            entry[i] = xlat_desc(ctx, attr, addr_pa, level);
+        }
 #if !HW_ASSISTED_COHERENCY
-        dccvac((uintptr_t)entry);
+        clean_dcache_range((uintptr_t)entry, run * sizeof(uint64_t));
 #endif
-        base_va += PAGE_SIZE;
+        base_va += run * PAGE_SIZE;
+        pages_count -= run;
     }
 
     /* Ensure that the last descriptor written is seen by the system. */
@@ -10,7 +10,17 @@
 # Prerequists: Make sure RMM ACS, RMM and TFA builds are complete
 # Usage:
 #   ./run.sh --model <fvp_binary_full_path> --bl1 <full_path_to_tf-a-bl1.bin> \
-#             --fip <full_path_to_tf-a-fip.bin> --acs_build_dir <full_path_to_rmm-acs/build>
+#             --fip <full_path_to_tf-a-fip.bin> --acs_build_dir <full_path_to_rmm-acs/build> \
+#             [-j <number_of_parallel_models>] [--shards <number_of_shards>]
+#
+# Note : -j only applies to per test images (TEST_COMBINE=OFF). Each test writes
+#        its UART and model logs into its own output/<suite>/<test>/ directory
+#        and the run time of every test is saved in output/test_timing.log, so
+#        that the next run can start the longest tests first.
+#
+# Note : --shards splits a combined image (TEST_COMBINE=ON) across several
+#        models. Each model gets its shard index preloaded in the NVM and logs
+#        into output/shard_<index>/. Use -j to run the shards in parallel.
 #
 # Note : For ACS secure test, make sure acs_secure.bin is part of fip image.
 #------------------------------------------------------------------------------
@@ -19,18 +29,26 @@
 # Set defaults
 #------------------------------------------------------------------------------
 ACS_NS_PRELOAD_ADDR_DFLT=0x88000000
+# PLATFORM_NVM_BASE + PLATFORM_NVM_TEST_SHARD_OFFSET
+ACS_SHARD_PRELOAD_ADDR_DFLT=0x82807ff0
+# VAL_TEST_SHARD_MAGIC
+ACS_SHARD_MAGIC=0x44524853
 arg_dryrun=
 arg_model=
 arg_bl1=
 arg_fip=
 arg_acs_build_dir=
 arg_acs_ns_preload_addr=${ACS_NS_PRELOAD_ADDR_DFLT}
+arg_acs_shard_preload_addr=${ACS_SHARD_PRELOAD_ADDR_DFLT}
 # Run the test with a timeout so they can't loop forever.
 arg_test_timeout=30
+arg_jobs=1
+arg_shards=1
 suite_timeout_multiplier=3
 test_report_logfile=
 regression_report_logfile=
 tfa_rmm_logfile=
+test_timing_logfile=
 
 fvp_cmd=" -C bp.refcounter.non_arch_start_at_default=1 \
 -C bp.refcounter.use_real_time=0 \
@@ -80,6 +98,149 @@ fvp_cmd=" -C bp.refcounter.non_arch_start_at_default=1 \
 -C bp.pl011_uart1.uart_enable=1 \
 -C bp.pl011_uart2.uart_enable=1 "
 
+#------------------------------------------------------------------------------
+# Functions
+#------------------------------------------------------------------------------
+function print_help()
+{
+    echo "run.sh [options] [-- [model_options]]"
+    echo ""
+    echo "Model Configuration:"
+    echo "  --model PATH           <path_to_model_bin>"
+    echo ""
+    echo "Images:"
+    echo "  --bl1                  <path_to_bl1.bin>"
+    echo "  --fip                  <path_to_fip.bin>"
+    echo "  --acs_build_dir        <path_to_acs_build_directory>"
+    echo "  --acs_ns_preload_addr  <Address where acs_non_secure.bin to be preloaded>"
+    echo "                       (default: ${ACS_NS_PRELOAD_ADDR_DFLT})"
+    echo "  --acs_shard_preload_addr <Address where the shard selection is preloaded>"
+    echo "                       (default: ${ACS_SHARD_PRELOAD_ADDR_DFLT})"
+    echo "Other options:"
+    echo "  --test_timeout          Run each test with specified timeout in seconds"
+    echo "                          (default: ${arg_test_timeout}s)"
+    echo "  -j / --jobs N           Run up to N models in parallel"
+    echo "                          (default: ${arg_jobs})"
+    echo "  --shards N              Split a combined image across N models"
+    echo "                          (default: ${arg_shards})"
+    echo "  --help                  Print this message"
+    echo "  -n / --dry-run          Print command but don't execute anything"
+    echo ""
+    echo "Options passed after an empty '--' are passed straight to the model"
+}
+
+# List the per test images as <suite>/<test>, sorted so that the merged
+# regression report does not depend on the filesystem or locale order.
+function list_tests()
+{
+    local bin
+
+    for bin in ${arg_acs_build_dir}/output/*/*/acs_non_secure.bin; do
+        if [[ -f ${bin} ]]
+        then
+            bin=${bin#${arg_acs_build_dir}/output/}
+            echo ${bin%/acs_non_secure.bin}
+        fi
+    done | LC_ALL=C sort
+}
+
+# Order the tests longest-job-first using the timings of the previous run.
+# Tests without a recorded time are assumed to run up to the timeout.
+function schedule_tests()
+{
+    list_tests | awk -v dflt=${arg_test_timeout} -v timing=${test_timing_logfile} '
+        BEGIN {
+            while ((getline line < timing) > 0) {
+                split(line, f, " ")
+                secs[f[2]] = f[1]
+            }
+        }
+        { print (($0 in secs) ? secs[$0] : dflt), $0 }' |
+    LC_ALL=C sort -k1,1nr -k2,2 | cut -d" " -f2
+}
+
+# Run the model for one test. uart0/1 go to the test's own tfa_rmm.log and
+# uart2 to its test_report.log, so concurrent models never share a file.
+function run_test()
+{
+    local test_dir=${arg_acs_build_dir}/output/$1
+    local test_report_logfile=${test_dir}/test_report.log
+    local tfa_rmm_logfile=${test_dir}/tfa_rmm.log
+    local fvp_cmd_test="${fvp_cmd} \
+ --data cluster0.cpu0=${test_dir}/acs_non_secure.bin@${arg_acs_ns_preload_addr} \
+ -C bp.pl011_uart2.out_file=${test_report_logfile}"
+    local start
+
+    if [[ ${arg_dryrun} = "yes" ]]
+    then
+        echo "Running model command for $1: timeout $arg_test_timeout $fvp_cmd_test"
+        return
+    fi
+
+    rm -f $test_report_logfile $tfa_rmm_logfile ${test_dir}/test_timing.log
+    echo "Running model command for $1: timeout $arg_test_timeout $fvp_cmd_test" \
+        > ${tfa_rmm_logfile}
+    start=$SECONDS
+    if [[ ${arg_jobs} -eq 1 ]]
+    then
+        timeout $arg_test_timeout $fvp_cmd_test | tee -a ${tfa_rmm_logfile}
+    else
+        echo "Running $1"
+        timeout $arg_test_timeout $fvp_cmd_test >> ${tfa_rmm_logfile} 2>&1
+    fi
+    echo "$((SECONDS - start)) $1" > ${test_dir}/test_timing.log
+    echo "Model command completed for $1"
+}
+
+# Print a 32-bit value as the printf escapes of its little endian bytes
+function le32()
+{
+    local val=$(($1))
+
+    printf '\\x%02x\\x%02x\\x%02x\\x%02x' $((val & 0xff)) $(((val >> 8) & 0xff)) \
+        $(((val >> 16) & 0xff)) $(((val >> 24) & 0xff))
+}
+
+# Run one shard of the combined image. val_host_test_dispatch() reads the
+# val_host_test_shard_ts preloaded in the NVM and only runs its tests.
+function run_shard()
+{
+    local shard_dir=${arg_acs_build_dir}/output/shard_$1
+    local fvp_cmd_shard="${fvp_cmd} \
+ --data cluster0.cpu0=${arg_acs_build_dir}/output/acs_non_secure.bin@${arg_acs_ns_preload_addr} \
+ --data cluster0.cpu0=${shard_dir}/test_shard.bin@${arg_acs_shard_preload_addr} \
+ -C bp.pl011_uart2.out_file=${shard_dir}/regression_report.log"
+
+    echo "Running model command for shard $1: timeout $arg_test_timeout $fvp_cmd_shard"
+    if [[ ${arg_dryrun} = "yes" ]]
+    then
+        return
+    fi
+
+    mkdir -p ${shard_dir}
+    rm -f ${shard_dir}/regression_report.log ${shard_dir}/tfa_rmm.log
+    printf "$(le32 ${ACS_SHARD_MAGIC})$(le32 $1)$(le32 ${arg_shards})" \
+        > ${shard_dir}/test_shard.bin
+    timeout $arg_test_timeout $fvp_cmd_shard > ${shard_dir}/tfa_rmm.log 2>&1
+    echo "Model command completed for shard $1"
+}
+
+# Run the job given as first argument once for each of the other arguments,
+# with at most arg_jobs models alive at a time.
+function run_jobs()
+{
+    local job=$1 item
+
+    shift
+    for item in "$@"; do
+        while [[ $(jobs -rp | wc -l) -ge ${arg_jobs} ]]; do
+            wait -n
+        done
+        $job $item &
+    done
+    wait
+}
+
 #------------------------------------------------------------------------------
 # Main
 #------------------------------------------------------------------------------
@@ -109,12 +270,24 @@ case "$1" in
         arg_acs_ns_preload_addr="$2"
         shift 2
         ;;
+    --acs_shard_preload_addr)
+        arg_acs_shard_preload_addr="$2"
+        shift 2
+        ;;
 
     # Other options
     --arg_test_timeout)
         arg_test_timeout="$2"
         shift 2
         ;;
+    -j | --jobs)
+        arg_jobs="$2"
+        shift 2
+        ;;
+    --shards)
+        arg_shards="$2"
+        shift 2
+        ;;
     -n | --dry-run)
         arg_dryrun=yes
         shift 1
@@ -155,6 +328,14 @@ elif [[ ${arg_acs_build_dir} = "" ]] || [[ ! -d ${arg_acs_build_dir} ]]
 then
     echo "Error! --acs_build_dir parameter not set properly"
     exit 1
+elif [[ ! ${arg_jobs} =~ ^[1-9][0-9]*$ ]]
+then
+    echo "Error! -j parameter not set properly"
+    exit 1
+elif [[ ! ${arg_shards} =~ ^[1-9][0-9]*$ ]]
+then
+    echo "Error! --shards parameter not set properly"
+    exit 1
 fi
 
 fvp_cmd="${arg_model} ${fvp_cmd} \
@@ -166,7 +347,17 @@ fvp_cmd="${fvp_cmd} $@"
 
 regression_report_logfile=${arg_acs_build_dir}/output/regression_report.log
 
-if [[ -f "${arg_acs_build_dir}/output/acs_non_secure.bin" ]]
+if [[ -f "${arg_acs_build_dir}/output/acs_non_secure.bin" ]] && [[ ${arg_shards} -gt 1 ]]
+then
+    arg_test_timeout=$(($arg_test_timeout * $suite_timeout_multiplier))
+
+    run_jobs run_shard $(seq 0 $((arg_shards - 1)))
+
+    # Every shard prints the counters of its own tests, the summary below adds them up
+    for ((shard = 0; shard < arg_shards; shard++)); do
+        cat ${arg_acs_build_dir}/output/shard_$shard/regression_report.log 2>/dev/null
+    done | tee $regression_report_logfile
+elif [[ -f "${arg_acs_build_dir}/output/acs_non_secure.bin" ]]
 then
     tfa_rmm_logfile=${arg_acs_build_dir}/output/tfa_rmm.log
 
@@ -187,38 +378,22 @@ then
     fi
     echo "Model command completed"
 else
-    cd ${arg_acs_build_dir}/output/
-    for suite in */;do
-        cd $suite
-
-        for testcase in */; do
-                if [[ -f "${arg_acs_build_dir}/output/$suite/$testcase/acs_non_secure.bin" ]]
-                then
-                    test_report_logfile=${arg_acs_build_dir}/output/$suite/$testcase/test_report.log
-                    tfa_rmm_logfile=${arg_acs_build_dir}/output/$suite/$testcase/tfa_rmm.log
-                    fvp_cmd_test="${fvp_cmd} \
- --data cluster0.cpu0=\
-${arg_acs_build_dir}/output/$suite/$testcase/acs_non_secure.bin@${arg_acs_ns_preload_addr} \
- -C bp.pl011_uart2.out_file=${test_report_logfile}"
+    test_timing_logfile=${arg_acs_build_dir}/output/test_timing.log
 
-                    msg="Running model command for $testcase: timeout
-                         $arg_test_timeout $fvp_cmd_test | tee -a ${tfa_rmm_logfile}"
-                    echo $msg | tee -a ${tfa_rmm_logfile}
-                    if [[ ${arg_dryrun} != "yes" ]]
-                    then
-                    # Execute the command
-                    rm -f $test_report_logfile $tfa_rmm_logfile
-                    timeout $arg_test_timeout $fvp_cmd_test | tee -a ${tfa_rmm_logfile}
-                    #Generate regression summary
-                    fi
-                    echo "Model command completed"
-                fi
-        done
+    run_jobs run_test $(schedule_tests)
 
-        cd -
-    done
-    # Gether logs from all tests into one file
-    find . -type f | grep "test_report.log\b" | xargs cat | tee $regression_report_logfile
+    if [[ ${arg_dryrun} != "yes" ]]
+    then
+        # Save the run times for the next longest-job-first schedule
+        for testcase in $(list_tests); do
+            cat ${arg_acs_build_dir}/output/$testcase/test_timing.log 2>/dev/null
+        done > ${test_timing_logfile}
+    fi
+
+    # Gether logs from all tests into one file, in test order
+    for testcase in $(list_tests); do
+        cat ${arg_acs_build_dir}/output/$testcase/test_report.log 2>/dev/null
+    done | tee $regression_report_logfile
 fi
 
 total_tests=`grep -c "Suite=" $regression_report_logfile`
@@ -237,28 +412,3 @@ Total Fail  :$total_fail
 ***************************"
 exit 0
 
-#------------------------------------------------------------------------------
-# Functions
-#------------------------------------------------------------------------------
-function print_help()
-{
-    echo "run.sh [options] [-- [model_options]]"
-    echo ""
-    echo "Model Configuration:"
-    echo "  --model PATH           <path_to_model_bin>"
-    echo ""
-    echo "Images:"
-    echo "  --bl1                  <path_to_bl1.bin>"
-    echo "  --fip                  <path_to_fip.bin>"
-    echo "  --acs_build_dir        <path_to_acs_build_directory>"
-    echo "  --acs_ns_preload_addr  <Address where acs_non_secure.bin to be preloaded>"
-    echo "                       (default: ${ACS_NS_PRELOAD_ADDR_DFLT})"
-    echo "Other options:"
-    echo "  --test_timeout          Run each test with specified timeout in seconds"
-    echo "                          (default: ${arg_test_timeout}s)"
-    echo "  --help                  Print this message"
-    echo "  -n / --dry-run          Print command but don't execute anything"
-    echo ""
-    echo "Options passed after an empty '--' are passed straight to the model"
-}
-
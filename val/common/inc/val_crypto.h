@@ -16,6 +16,13 @@
 #define PUBLIC_KEY_ALGO_ECDSA_ECC_NIST_P384    0x20
 #define PUBLIC_KEY_ALGO_RSASSA_3072        0x30
 
+#define VAL_SHA256_SIZE                    32U
+
+/* Leaf public keys kept by val_host_get_public_key_from_cert_chain() */
+#define VAL_KEY_CACHE_ENTRIES              4U
+#define VAL_KEY_CACHE_KEY_MAX              384U
+#define VAL_KEY_CACHE_METADATA_MAX         16U
+
 int val_host_get_public_key_from_cert_chain(uint8_t *cert_chain,
                     size_t cert_chain_len,
                     void *public_key,
@@ -23,5 +30,8 @@ int val_host_get_public_key_from_cert_chain(uint8_t *cert_chain,
                     void *public_key_metadata,
                     size_t *public_key_metadata_len,
                     uint8_t *public_key_algo);
+uint32_t val_sha2_backend_get(void);
+uint32_t val_sha2_digest(uint32_t backend, uint32_t alg, const uint8_t *data,
+                         size_t len, uint8_t *digest);
 
 #endif /* _VAL_CRYPTO_H_ */
\ No newline at end of file
@@ -25,6 +25,7 @@
 int val_memcmp(void *src, void *dest, size_t len);
 void *val_memcpy(void *dst, const void *src, size_t len);
 void val_memset(void *dst, int val, size_t count);
+void val_memzero(void *dst, size_t count);
 char *val_strcat(char *str1, char *str2, size_t output_buff_size);
 int val_strcmp(char *str1, char *str2);
 size_t val_strlen(char *str);
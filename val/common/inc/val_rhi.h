@@ -28,6 +28,25 @@ typedef enum {
 
 #define RHI_SMC_NOT_SUPPORTED 0xFFFFFFFFFFFFFFFF
 
+/*
+ * FAL streaming window: a multi-page NS buffer mapped into the Realm once.
+ * The header is followed, at RHI_FAL_WINDOW_DATA_OFFSET, by a ring of log
+ * data. The host advances prod on RHI_FAL_READ, the Realm advances cons as it
+ * drains the ring. Both indices only grow, the ring offset is index % data_size.
+ */
+#define RHI_FAL_WINDOW_DATA_OFFSET 0x40
+
+typedef struct {
+    /* Log bytes written into the ring by the host */
+    volatile uint64_t prod;
+    /* Log bytes drained from the ring by the Realm */
+    volatile uint64_t cons;
+    /* Size of the ring in bytes */
+    uint64_t data_size;
+    /* Size of the complete log in bytes */
+    uint64_t log_size;
+} val_rhi_fal_window_ts;
+
 #define RHI_SESSION_VER 0x10000
 #define RHI_FAL_VER 0x10000
 #define RHI_DA_VER 0x10000
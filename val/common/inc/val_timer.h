@@ -15,6 +15,9 @@
 #define ARM_ARCH_TIMER_IMASK            (1ULL << 1)
 #define ARM_ARCH_TIMER_ISTATUS          (1ULL << 2)
 
+/* Target interval of the timer event stream that wakes up WFE based waits */
+#define VAL_TIMER_EVENT_PERIOD_US       100U
+
 void val_disable_phy_timer_el1(void);
 void val_timer_set_phy_el1(uint64_t timeout, bool irq_mask);
 void val_disable_virt_timer_el1(void);
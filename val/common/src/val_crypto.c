@@ -8,6 +8,22 @@
 
 #include "val.h"
 #include "val_crypto.h"
+#include "val_libc.h"
+#include "mbedtls/sha256.h"
+
+typedef struct {
+    uint8_t chain_hash[VAL_SHA256_SIZE];
+    uint8_t public_key[VAL_KEY_CACHE_KEY_MAX];
+    uint8_t public_key_metadata[VAL_KEY_CACHE_METADATA_MAX];
+    size_t public_key_len;
+    size_t public_key_metadata_len;
+    uint64_t last_use;
+    uint8_t public_key_algo;
+    bool valid;
+} val_key_cache_ts;
+
+static val_key_cache_ts key_cache[VAL_KEY_CACHE_ENTRIES];
+static uint64_t key_cache_tick;
 
 static int host_get_leaf_cert_from_cert_chain(uint8_t *cert_chain,
                           size_t cert_chain_len,
@@ -57,7 +73,7 @@ static int host_get_leaf_cert_from_cert_chain(uint8_t *cert_chain,
     return 0;
 }
 
-int val_host_get_public_key_from_cert_chain(uint8_t *cert_chain,
+static int host_parse_public_key_from_cert_chain(uint8_t *cert_chain,
                         size_t cert_chain_len,
                         void *public_key,
                         size_t *public_key_len,
@@ -169,4 +185,141 @@ out_crt_free:
     // mbedtls_x509_crt_free(&crt);
 
     return rc;
-}
\ No newline at end of file
+}
+
+/**
+  @brief  Copy the leaf public key of a certificate chain from the LRU cache
+  @param  chain_hash  - SHA-256 of the certificate chain
+  @param  others      - same as val_host_get_public_key_from_cert_chain
+  @return Returns true on a hit, false otherwise
+**/
+static bool host_key_cache_lookup(const uint8_t *chain_hash,
+                        void *public_key,
+                        size_t *public_key_len,
+                        void *public_key_metadata,
+                        size_t *public_key_metadata_len,
+                        uint8_t *public_key_algo)
+{
+    val_key_cache_ts *entry;
+    uint32_t i;
+
+    for (i = 0; i < VAL_KEY_CACHE_ENTRIES; i++)
+    {
+        entry = &key_cache[i];
+        if (!entry->valid ||
+            val_memcmp(entry->chain_hash, (void *)chain_hash, VAL_SHA256_SIZE) != 0)
+            continue;
+
+        val_memcpy(public_key, entry->public_key, entry->public_key_len);
+        val_memcpy(public_key_metadata, entry->public_key_metadata,
+                   entry->public_key_metadata_len);
+        *public_key_len = entry->public_key_len;
+        *public_key_metadata_len = entry->public_key_metadata_len;
+        *public_key_algo = entry->public_key_algo;
+        entry->last_use = ++key_cache_tick;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+  @brief  Store a parsed leaf public key, replacing the least recently used entry
+  @param  chain_hash  - SHA-256 of the certificate chain
+  @param  others      - key returned by host_parse_public_key_from_cert_chain
+  @return None
+**/
+static void host_key_cache_insert(const uint8_t *chain_hash,
+                        const void *public_key,
+                        size_t public_key_len,
+                        const void *public_key_metadata,
+                        size_t public_key_metadata_len,
+                        uint8_t public_key_algo)
+{
+    val_key_cache_ts *entry = &key_cache[0];
+    uint32_t i;
+
+    if (public_key_len > VAL_KEY_CACHE_KEY_MAX ||
+        public_key_metadata_len > VAL_KEY_CACHE_METADATA_MAX)
+        return;
+
+    for (i = 0; i < VAL_KEY_CACHE_ENTRIES; i++)
+    {
+        if (!key_cache[i].valid)
+        {
+            entry = &key_cache[i];
+            break;
+        }
+
+        if (key_cache[i].last_use < entry->last_use)
+            entry = &key_cache[i];
+    }
+
+    val_memcpy(entry->chain_hash, chain_hash, VAL_SHA256_SIZE);
+    val_memcpy(entry->public_key, public_key, public_key_len);
+    val_memcpy(entry->public_key_metadata, public_key_metadata, public_key_metadata_len);
+    entry->public_key_len = public_key_len;
+    entry->public_key_metadata_len = public_key_metadata_len;
+    entry->public_key_algo = public_key_algo;
+    entry->last_use = ++key_cache_tick;
+    entry->valid = true;
+}
+
+int val_host_get_public_key_from_cert_chain(uint8_t *cert_chain,
+                        size_t cert_chain_len,
+                        void *public_key,
+                        size_t *public_key_len,
+                        void *public_key_metadata,
+                        size_t *public_key_metadata_len,
+                        uint8_t *public_key_algo)
+{
+    uint8_t chain_hash[VAL_SHA256_SIZE];
+    bool hashed;
+    int rc;
+
+    /* Repeat lookups of a device chain skip the X.509 parsing */
+    hashed = (mbedtls_sha256(cert_chain, cert_chain_len, chain_hash, 0) == 0);
+    if (hashed && host_key_cache_lookup(chain_hash, public_key, public_key_len,
+                                        public_key_metadata, public_key_metadata_len,
+                                        public_key_algo))
+        return 0;
+
+    rc = host_parse_public_key_from_cert_chain(cert_chain, cert_chain_len,
+                        public_key, public_key_len, public_key_metadata,
+                        public_key_metadata_len, public_key_algo);
+    if (rc == 0 && hashed)
+        host_key_cache_insert(chain_hash, public_key, *public_key_len,
+                              public_key_metadata, *public_key_metadata_len,
+                              *public_key_algo);
+
+    return rc;
+}
+
+/**
+ * @brief  Returns the SHA-2 block backends implemented by the PE
+ * @param  void
+ * @return Returns a mask of PAL_SHA2_BACKEND_CE_* bits, PAL_SHA2_BACKEND_C if
+ *         only the portable code is usable
+ **/
+uint32_t val_sha2_backend_get(void)
+{
+    return pal_sha2_backend_get();
+}
+
+/**
+ * @brief  Hashes a buffer through one given SHA-2 block backend
+ * @param  backend - PAL_SHA2_BACKEND_C, or the PAL_SHA2_BACKEND_CE_* bit of alg
+ * @param  alg     - PAL_SHA2_ALG_SHA256, PAL_SHA2_ALG_SHA384 or PAL_SHA2_ALG_SHA512
+ * @param  data    - input buffer
+ * @param  len     - input size in bytes
+ * @param  digest  - output buffer, at least PAL_SHA2_DIGEST_SIZE(alg) bytes
+ * @return Returns VAL_SUCCESS, VAL_ERROR if the backend or algorithm is not usable
+ **/
+uint32_t val_sha2_digest(uint32_t backend, uint32_t alg, const uint8_t *data,
+                         size_t len, uint8_t *digest)
+{
+    if (pal_sha2_digest(backend, alg, data, len, digest))
+        return VAL_ERROR;
+
+    return VAL_SUCCESS;
+}
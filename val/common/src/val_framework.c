@@ -110,35 +110,34 @@ void val_realm_printf(print_verbosity_t verbosity, const char *fmt, ...)
 **/
 void val_print_secuity_state(void)
 {
-    uint64_t prev_log_state = (*(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET));
+    uint64_t *log_state = (uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET);
+
+    /* Common case: the previous message came from this same security state */
+    if (*log_state == security_state)
+    {
+        if ((security_state == SEC_STATE_NS) || (security_state == SEC_STATE_REALM) ||
+            (security_state == SEC_STATE_SECURE))
+            return;
+    }
 
     if (security_state == SEC_STATE_NS)
     {
-        if (prev_log_state != security_state)
+        *log_state = security_state;
+        if (skip_for_val_logs == 1)
         {
-            *(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET) = security_state;
-            if (skip_for_val_logs == 1)
-            {
-                LOG(ALWAYS, "Host:\n");
-            }
+            LOG(ALWAYS, "Host:\n");
         }
     }
 
     else if (security_state == SEC_STATE_REALM)
     {
-        if (prev_log_state != security_state)
-        {
-            *(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET) = security_state;
-            LOG(ALWAYS, "Realm:\n");
-        }
+        *log_state = security_state;
+        LOG(ALWAYS, "Realm:\n");
     }
     else if (security_state == SEC_STATE_SECURE)
     {
-        if (prev_log_state != security_state)
-        {
-            *(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET) = security_state;
-            LOG(ALWAYS, "Secure:\n");
-        }
+        *log_state = security_state;
+        LOG(ALWAYS, "Secure:\n");
     }
     else
     {
@@ -7,6 +7,13 @@
 
 #include "val_libc.h"
 
+/* Doubleword that may alias any other type, for the word at a time loops */
+typedef uint64_t __attribute__((__may_alias__)) val_word_t;
+
+#define VAL_WORD_ALIGN_MASK     (sizeof(val_word_t) - 1)
+#define VAL_WORD_HAS_ZERO(w)    ((((w) - 0x0101010101010101ULL) & ~(w) & \
+                                  0x8080808080808080ULL) != 0)
+
 /**
   @brief  Compare the two input buffer content
   @param  src   - Source buffer to be compared
@@ -42,6 +49,17 @@ void val_memset(void *dst, int val, size_t count)
   pal_memset(dst, val, count);
 }
 
+/**
+  @brief  Zero a buffer in Normal memory, using DC ZVA where permitted
+  @param  - dst   : Pointer to the buffer to zero
+          - count : Number of bytes in buffer to zero
+  @return None
+**/
+void val_memzero(void *dst, size_t count)
+{
+  pal_memzero(dst, count);
+}
+
 /**
   @brief  Appends the string pointed to by str2 to the
           end of the string pointed to by str1
@@ -53,12 +71,7 @@ void val_memset(void *dst, int val, size_t count)
 
 char *val_strcat(char *str1, char *str2, size_t output_buff_size)
 {
-  size_t length = 0, i;
-
-  while (str1[length] != '\0')
-  {
-    ++length;
-  }
+  size_t length = val_strlen(str1), i;
 
   /* Concatenate str1 to str2 */
   for (i = 0; str2[i] != '\0'; ++i, ++length)
@@ -85,29 +98,47 @@ char *val_strcat(char *str1, char *str2, size_t output_buff_size)
 **/
 int val_strcmp(char *str1, char *str2)
 {
-  int ret = 0;
+  const val_word_t *w1;
+  const val_word_t *w2;
 
-  /* Compare str1 to str2 */
-  while (*str1)
+  /* Compare a doubleword at a time while str1 does not end in it */
+  if ((((uintptr_t)str1 ^ (uintptr_t)str2) & VAL_WORD_ALIGN_MASK) == 0)
+  {
+    while (((uintptr_t)str1 & VAL_WORD_ALIGN_MASK) != 0)
     {
-        if (*str1 != *str2) {
-            ret = 1;
-            break;
-        }
-
-        str1++;
-        str2++;
+      if (*str1 == '\0')
+        return 0;
+      if (*str1 != *str2)
+        return 1;
+      str1++;
+      str2++;
     }
 
-    if (ret == 0)
+    w1 = (const val_word_t *)(uintptr_t)str1;
+    w2 = (const val_word_t *)(uintptr_t)str2;
+
+    while (!VAL_WORD_HAS_ZERO(*w1))
     {
-      return 0;
+      if (*w1 != *w2)
+        return 1;
+      w1++;
+      w2++;
     }
-    else
-    {
+
+    str1 = (char *)(uintptr_t)w1;
+    str2 = (char *)(uintptr_t)w2;
+  }
+
+  while (*str1)
+  {
+    if (*str1 != *str2)
       return 1;
-    }
 
+    str1++;
+    str2++;
+  }
+
+  return 0;
 }
 
 /**
@@ -134,6 +165,14 @@ void val_assert(const char *e, uint64_t line, const char *file)
     pal_assert(e, line, file);
 }
 
+/* Digit tables for unsigned_num_print() */
+static const char hex_digits[] = "0123456789abcdef";
+static const char dec_digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
 /**
  * @brief Prints a string to a buffer while tracking the number of characters printed.
  *
@@ -177,15 +216,29 @@ static void unsigned_num_print(char **s, size_t n, size_t *count,
     int width;
     unsigned int rem;
 
-    do {
-        rem = (unsigned int)unum % radix;
-        if (rem < 0xa)
-            num_buf[i] = '0' + (char)rem;
-        else
-            num_buf[i] = 'a' + (char)(rem - 0xa);
-        i++;
-        unum /= radix;
-    } while (unum > 0U);
+    if (radix == 16U) {
+        /* Hex digits come straight from the nibbles, no division needed */
+        do {
+            num_buf[i++] = hex_digits[unum & 0xfU];
+            unum >>= 4;
+        } while (unum > 0U);
+    } else {
+        /* Two decimal digits per division by a constant */
+        while (unum >= 100U) {
+            rem = (unsigned int)(unum % 100U);
+            unum /= 100U;
+            num_buf[i++] = dec_digit_pairs[(2U * rem) + 1U];
+            num_buf[i++] = dec_digit_pairs[2U * rem];
+        }
+
+        if (unum >= 10U) {
+            rem = (unsigned int)unum;
+            num_buf[i++] = dec_digit_pairs[(2U * rem) + 1U];
+            num_buf[i++] = dec_digit_pairs[2U * rem];
+        } else {
+            num_buf[i++] = (char)('0' + (char)unum);
+        }
+    }
 
     width = i;
 
@@ -345,13 +398,22 @@ loop:
             continue;
         }
 
+        /* Copy the whole run of literal characters up to the next specifier */
+        const char *run = fmt;
+        size_t run_len;
+
+        while ((*fmt != '\0') && (*fmt != '%'))
+            fmt++;
+
+        run_len = (size_t)(fmt - run);
         if (count < n) {
-            *s = *fmt;
-            s++;
+            size_t copy_len = ((n - count) < run_len) ? (n - count) : run_len;
+
+            val_memcpy(s, run, copy_len);
+            s += copy_len;
         }
 
-        fmt++;
-        count++;
+        count += run_len;
     }
 
     if (n > 0U)
@@ -145,30 +145,69 @@ void val_timer_set_phy_el2(uint64_t timeout)
 }
 
 /**
- *   @brief   This API Executes software loop based wait for ms.
- *   @param   ms   - wait loop timeout value
+ *   @brief   Makes the generic timer send a WFE wake-up event every
+ *            VAL_TIMER_EVENT_PERIOD_US, so that a core waiting on the counter
+ *            can sleep in WFE rather than spin. The event stream is enabled
+ *            through CNTHCTL_EL2 at EL2 and through CNTKCTL_EL1 at EL1.
+ *   @param   el   - current exception level
  *   @return  void
 **/
-static inline void val_wait_loop(uint64_t ms)
+static void val_timer_event_stream_enable(unsigned int el)
 {
-    uint64_t timeout = ms * ITERATIONS_PER_MS;
-    uint64_t loop;
-    volatile uint64_t count = 0; /* to prevent optimization*/
+    uint64_t ctl = (el == MODE_EL2) ? read_cnthctl_el2() : read_cntkctl_el1();
+    uint64_t period = (read_cntfrq_el0() * VAL_TIMER_EVENT_PERIOD_US) / 1000000U;
+    uint64_t evnti = 0;
 
-    for (loop = 0; loop < timeout; loop++) {
-        /* Wait */
-        count++;
+    if ((ctl & EVNTEN_BIT) != 0U)
+        return;
+
+    /* An event is generated each time counter bit EVNTI toggles, every 2^(EVNTI + 1) ticks */
+    while ((evnti < EVNTI_MASK) && ((2ULL << (evnti + 1U)) <= period))
+        evnti++;
+
+    ctl &= ~(((uint64_t)EVNTI_MASK << EVNTI_SHIFT) | EVNTDIR_BIT);
+    ctl |= (evnti << EVNTI_SHIFT) | EVNTEN_BIT;
+
+    if (el == MODE_EL2)
+        write_cnthctl_el2(ctl);
+    else
+        write_cntkctl_el1(ctl);
+    isb();
+}
+
+/**
+ *   @brief   Waits until the given counter reaches deadline, sleeping in WFE
+ *            between timer events. At realm EL1 a WFE only leaves the realm
+ *            when the host entered the REC with trap_wfe set, and the tests
+ *            that do so never wait here.
+ *   @param   read_counter - physical or virtual counter read function
+ *   @param   deadline     - counter value to wait for
+ *   @return  counter value read at the end of the wait
+**/
+static uint64_t val_timer_wait_until(uint64_t (*read_counter)(void), uint64_t deadline)
+{
+    uint64_t now = read_counter();
+
+    val_timer_event_stream_enable(get_current_el());
+
+    while (now < deadline) {
+        wfe();
+        now = read_counter();
     }
+
+    return now;
 }
 
 /**
- *   @brief   This API Executes software loop based wait for ms.
- *   @param   ms   - wait loop timeout value
+ *   @brief   Waits for at least ms milliseconds on the generic timer.
+ *   @param   ms   - wait time in milli seconds
  *   @return  void
 **/
 void val_sp_sleep(uint64_t ms)
 {
-    val_wait_loop(ms);
+    uint64_t ticks = (ms * read_cntfrq_el0()) / 1000U;
+
+    (void)val_timer_wait_until(syscounter_read, syscounter_read() + ticks);
 }
 
 /**
@@ -200,11 +239,10 @@ uint64_t val_sleep_elapsed_time(uint64_t ms)
 {
     uint64_t timer_freq = read_cntfrq_el0();
     uint64_t time1 = virtualcounter_read();
-    volatile uint64_t time2 = time1;
+    uint64_t time2;
 
-    while ((time2 - time1) < ((ms * timer_freq) / 1000U)) {
-        time2 = virtualcounter_read();
-    }
+    time2 = val_timer_wait_until(virtualcounter_read,
+                                 time1 + ((ms * timer_freq) / 1000U));
 
     return ((time2 - time1) * 1000) / timer_freq;
 }
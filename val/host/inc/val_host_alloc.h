@@ -14,8 +14,18 @@
 #define __ADDR_ALIGN_MASK(a, mask)    (((a) + (mask)) & ~(mask))
 #define ADDR_ALIGN(a, b)              __ADDR_ALIGN_MASK(a, (typeof(a))(b) - 1)
 
+/* Number of pages kept zeroed between tests for val_host_mem_alloc_zeroed() */
+#ifndef VAL_HOST_ZERO_POOL_PAGES
+#define VAL_HOST_ZERO_POOL_PAGES      32
+#endif
+
 void val_host_mem_alloc_init(void);
+void val_host_mem_alloc_persist(bool enable);
+void val_host_mem_alloc_persist_release(void);
 void *val_host_mem_alloc(size_t alignment, size_t size);
+void *val_host_mem_alloc_zeroed(size_t alignment, size_t size);
+void val_host_mem_zero_pool_delegate(uint64_t addr, bool delegated);
+void val_host_mem_zero_pool_refill(void);
 void val_host_mem_free(void *ptr);
 void *mem_alloc(size_t alignment, size_t size);
 uint16_t val_host_get_vmid(void);
@@ -9,6 +9,7 @@
 #define VAL_HOST_DA_H
 
 #include "val_host_realm.h"
+#include "val_host_doe.h"
 
 /* Up to 6 PCIe memory BARs */
 #define NCOH_ADDR_RANGE_NUM    6U
@@ -51,6 +52,8 @@ typedef struct{
     unsigned char public_key_sig_algo;
     uint32_t bdf;
     uint32_t doe_cap_base;
+    /* DOE exchange in flight for this device, progressed by the DOE engine */
+    val_host_doe_ctx_ts doe_ctx;
     uint16_t root_id;
     unsigned long ncoh_num_addr_range;
     val_host_address_range_ts ncoh_addr_range[NCOH_ADDR_RANGE_NUM];
@@ -91,6 +94,10 @@ uint64_t val_host_dev_communicate(val_host_realm_ts *realm,
                 val_host_vdev_ts *vdev_obj,
                 unsigned char target_state);
 
+uint64_t val_host_pdevs_communicate(val_host_pdev_ts **pdev_objs,
+                uint32_t count,
+                unsigned char target_state);
+
 void val_host_get_addr_range(val_host_pdev_ts *pdev_obj);
 
 uint32_t val_host_vdev_teardown(val_host_realm_ts *realm,
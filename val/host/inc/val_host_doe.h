@@ -8,15 +8,56 @@
 #ifndef __VAL_HOST_DOE_H__
 #define __VAL_HOST_DOE_H__
 
+#include "val_host_pcie.h"
+
 #define VAL_HOST_DOE_HEADER_1        0x10001
 #define VAL_HOST_DOE_HEADER_2        0x20001
 #define VAL_HOST_DOE_HEADER_LENGTH   0x2
 
+#define VAL_HOST_DOE_CTRL_ABORT      (1U << 0)
+#define VAL_HOST_DOE_CTRL_GO         (1U << 31)
+
+/* PCIe DOE: a response object must be ready within 1 second of GO */
+#define VAL_HOST_DOE_TIMEOUT_MS      1000U
+
+/* Maximum number of DOE exchanges that can be interleaved in one wait */
+#define VAL_HOST_DOE_MAX_INFLIGHT    64U
+
+typedef enum {
+    VAL_HOST_DOE_IDLE = 0,
+    VAL_HOST_DOE_SENDING,
+    VAL_HOST_DOE_WAITING,
+    VAL_HOST_DOE_RECEIVING,
+    VAL_HOST_DOE_DONE,
+    VAL_HOST_DOE_ERROR
+} val_host_doe_state_te;
+
+/* Per DOE mailbox exchange context */
+typedef struct {
+    val_host_doe_state_te state;
+    uint32_t bdf;
+    uint32_t doe_cap_base;
+    uint8_t req_type;
+    uint32_t *req_addr;
+    uint64_t req_len;
+    uint32_t *resp_addr;
+    uint64_t resp_len;
+    uint64_t deadline;
+} val_host_doe_ctx_ts;
+
+#define VAL_HOST_DOE_IN_FLIGHT(ctx) \
+    (((ctx)->state != VAL_HOST_DOE_IDLE) && ((ctx)->state != VAL_HOST_DOE_DONE) && \
+     ((ctx)->state != VAL_HOST_DOE_ERROR))
+
 uint64_t val_host_pcie_doe_communicate(uint32_t bdf, uint32_t doe_cap_base,
              void *req_buf, size_t req_sz, void *rsp_buf, size_t *rsp_sz, uint8_t req_type);
 uint32_t val_host_pcie_doe_send_req(uint32_t bdf, uint32_t doe_cap_base, uint32_t *req_addr,
                                                         uint64_t req_len, uint8_t req_type);
 uint32_t val_host_pcie_doe_recv_resp(uint32_t bdf, uint32_t doe_cap_base, uint32_t *resp_addr,
                                                                  uint64_t *resp_len);
+uint32_t val_host_doe_start(val_host_doe_ctx_ts *ctx, uint32_t bdf, uint32_t doe_cap_base,
+                     void *req_buf, size_t req_sz, void *rsp_buf, uint8_t req_type);
+val_host_doe_state_te val_host_doe_poll(val_host_doe_ctx_ts *ctx);
+uint32_t val_host_doe_wait(val_host_doe_ctx_ts **ctx, uint32_t count);
 
 #endif /* __VAL_HOST_DOE_H__ */
@@ -15,6 +15,25 @@
 #include "val_host_mp.h"
 #include "platform_override_fvp.h"
 
+/* Number of entries in the slowest tests table of the regression report */
+#define VAL_TEST_TIMING_TOP_N     10U
+
+/* Duration of one test, persisted in NVM from PLATFORM_NVM_TEST_TIMING_OFFSET */
+typedef struct {
+    uint64_t ticks;     /* Generic timer ticks */
+    uint64_t cycles;    /* Host PMU cycles, 0 if a reset happened during the test */
+} val_host_test_time_ts;
+
+/* "SHRD", marks a valid shard selection at PLATFORM_NVM_TEST_SHARD_OFFSET */
+#define VAL_TEST_SHARD_MAGIC      0x44524853U
+
+/* Runs every shard_count-th test of the dispatch plan, starting at shard_index */
+typedef struct {
+    uint32_t magic;
+    uint32_t shard_index;
+    uint32_t shard_count;
+} val_host_test_shard_ts;
+
 void acs_host_entry(void);
 uint64_t val_host_get_secondary_cpu_entry(void);
 void val_host_main(bool primary_cpu_boot);
@@ -23,6 +42,6 @@ uint32_t val_host_realm_printf_msg_service(void);
 void val_host_set_reboot_flag(void);
 uint32_t val_host_get_last_run_test_info(test_info_t *test_info);
 void val_host_create_pcie_info_table(void);
-void val_pcie_create_info_table(uint64_t *pcie_info_table);
+void val_pcie_create_info_table(uint64_t *pcie_info_table, bool warm_reset);
 
 #endif /* _VAL_HOST_FRAMEWORK_H_ */
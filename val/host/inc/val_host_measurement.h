@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef _VAL_HOST_MEASUREMENT_H_
+#define _VAL_HOST_MEASUREMENT_H_
+
+#include "val.h"
+#include "val_host_realm.h"
+
+#define VAL_HOST_MEAS_MAX_SIZE      64U
+#define VAL_HOST_MEAS_REM_COUNT     4U
+
+/* Measurement descriptor types */
+#define VAL_HOST_MEAS_DESC_DATA     0x0U
+#define VAL_HOST_MEAS_DESC_REC      0x1U
+#define VAL_HOST_MEAS_DESC_RIPAS    0x2U
+
+/* Measurement descriptor of DATA_CREATE */
+typedef struct {
+    SET_MEMBER(uint8_t desc_type, 0x0, 0x8);
+    SET_MEMBER(uint64_t len, 0x8, 0x10);
+    SET_MEMBER(uint8_t rim[VAL_HOST_MEAS_MAX_SIZE], 0x10, 0x50);
+    SET_MEMBER(uint64_t ipa, 0x50, 0x58);
+    SET_MEMBER(uint64_t flags, 0x58, 0x60);
+    SET_MEMBER(uint8_t content[VAL_HOST_MEAS_MAX_SIZE], 0x60, 0x100);
+} val_host_meas_desc_data_ts;
+
+/* Measurement descriptor of REC_CREATE */
+typedef struct {
+    SET_MEMBER(uint8_t desc_type, 0x0, 0x8);
+    SET_MEMBER(uint64_t len, 0x8, 0x10);
+    SET_MEMBER(uint8_t rim[VAL_HOST_MEAS_MAX_SIZE], 0x10, 0x50);
+    SET_MEMBER(uint8_t content[VAL_HOST_MEAS_MAX_SIZE], 0x50, 0x90);
+} val_host_meas_desc_rec_ts;
+
+/* Measurement descriptor of RTT_INIT_RIPAS */
+typedef struct {
+    SET_MEMBER(uint8_t desc_type, 0x0, 0x8);
+    SET_MEMBER(uint64_t len, 0x8, 0x10);
+    SET_MEMBER(uint8_t rim[VAL_HOST_MEAS_MAX_SIZE], 0x10, 0x50);
+    SET_MEMBER(uint64_t base, 0x50, 0x58);
+    SET_MEMBER(uint64_t top, 0x58, 0x60);
+} val_host_meas_desc_ripas_ts;
+
+/* Reference measurements of one Realm */
+typedef struct {
+    uint64_t rd;
+    uint8_t hash_algo;
+    uint32_t size;
+    uint8_t rim[VAL_HOST_MEAS_MAX_SIZE];
+    uint8_t rem[VAL_HOST_MEAS_REM_COUNT][VAL_HOST_MEAS_MAX_SIZE];
+    bool valid;
+} val_host_meas_ts;
+
+void val_host_meas_realm_create(uint64_t rd, const val_host_realm_params_ts *params);
+void val_host_meas_realm_destroy(uint64_t rd);
+void val_host_meas_rec_create(uint64_t rd, const val_host_rec_params_ts *params);
+void val_host_meas_data_create(uint64_t rd, uint64_t ipa, const void *src, uint64_t flags);
+void val_host_meas_init_ripas(uint64_t rd, uint64_t base, uint64_t top);
+uint32_t val_host_meas_rem_extend(uint64_t rd, uint64_t index, const void *value, uint64_t size);
+const val_host_meas_ts *val_host_meas_get(uint64_t rd);
+
+#endif /* _VAL_HOST_MEASUREMENT_H_ */
@@ -70,6 +70,32 @@
 /* Allows storage of 2048 valid BDFs */
 #define PCIE_DEVICE_BDF_TABLE_SZ 8192
 
+/* Header of the PCIe device table saved in NVM */
+#define PCIE_NVM_TABLE_MAGIC     0x50434945  /* "PCIE" */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t num_entries;
+    uint64_t checksum;    /* Topology checksum over ECAM blocks and entries */
+} pcie_nvm_table_hdr;
+
+extern PCIE_CFG_MAP *g_pcie_cfg_map;
+
+/**
+  @brief  Returns the config space address of a function from the per-bus ECAM
+          map, 0 if the bus is not mapped for the segment of the bdf
+**/
+static inline addr_t val_pcie_cfg_addr(uint32_t bdf)
+{
+    uint32_t bus = PCIE_EXTRACT_BDF_BUS(bdf);
+
+    if ((g_pcie_cfg_map == NULL) || (g_pcie_cfg_map->ecam_base[bus] == 0) ||
+        (g_pcie_cfg_map->segment[bus] != PCIE_EXTRACT_BDF_SEG(bdf)))
+        return 0;
+
+    return (addr_t)(g_pcie_cfg_map->ecam_base[bus] + PCIE_CFG_OFFSET(bdf));
+}
+
 typedef enum {
     HEADER = 0,
     PCIE_CAP = 1,
@@ -207,5 +233,7 @@ uint32_t val_pcie_get_num_bdf(void);
 uint64_t val_pcie_find_doe_capability(uint32_t *num_bdf, uint32_t *bdf, uint32_t *doe_cap_base);
 uint32_t val_pcie_get_bar(uint32_t bdf, uint32_t offset, uint64_t *addr, uint64_t *size);
 void val_pcie_mem_enable(uint32_t bdf);
+uint32_t val_pcie_save_dev_table(void);
+uint32_t val_pcie_restore_dev_table(void);
 
 #endif /* _VAL_HOST_PCIE_H_*/
@@ -20,6 +20,9 @@
 typedef struct val_host_realm val_host_realm_ts;
 extern uint32_t g_da_vdev_count;
 uint64_t val_host_rhi_dispatch(val_host_realm_ts *realm);
+uint64_t val_host_rhi_dispatch_rec(val_host_realm_ts *realm, uint64_t rec_idx);
+uint32_t val_host_rhi_fal_stream_init(val_host_realm_ts *realm, uint64_t size);
+void val_host_rhi_realm_release(uint64_t rd);
 uint64_t val_rhi_da_vdev_get_interface_report(val_host_realm_ts *realm,
                                               val_host_vdev_ts *vdev_obj);
 uint64_t val_rhi_da_vdev_continue(val_host_realm_ts *realm,
@@ -46,6 +49,11 @@ uint64_t val_rhi_da_vdev_p2p_unbind(val_host_realm_ts *realm,
 uint64_t da_init(val_host_realm_ts *realm, val_host_pdev_ts *pdev_obj,
                   val_host_vdev_ts *vdev_obj, uint8_t vdev_state);
 
+#ifdef DA_PDEV_REUSE
+void da_release_shared_pdev(void);
+#endif
+bool da_pdev_is_shared(uint64_t pdev);
+
 uint64_t da_create_vdev(val_host_realm_ts *realm, val_host_pdev_ts *pdev_obj,
                         val_host_vdev_ts *vdev_obj, uint64_t vdev_id,
                         uint8_t vdev_state);
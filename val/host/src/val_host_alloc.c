@@ -17,8 +17,24 @@ static int number_of_regions;
 
 static uint64_t heap_base;
 static uint64_t heap_top;
+/* Heap from this address up to the end of the region survives val_host_mem_alloc_init() */
+static uint64_t heap_persist_base = PLATFORM_HEAP_REGION_BASE + PLATFORM_HEAP_REGION_SIZE;
+/* Allocations are carved from the top of the heap into the persistent part */
+static bool heap_persist;
 static uint16_t curr_vmid;
 
+/* State of a page of the pre-zeroed pool */
+typedef enum {
+    ZERO_POOL_DIRTY = 0,
+    ZERO_POOL_ZERO,
+    ZERO_POOL_USED,
+    ZERO_POOL_DELEGATED
+} val_host_zero_pool_state_te;
+
+/* Pages kept zeroed between tests for the single page zeroed allocations */
+static uint8_t zero_pool[VAL_HOST_ZERO_POOL_PAGES][PAGE_SIZE] __attribute__((aligned(PAGE_SIZE)));
+static val_host_zero_pool_state_te zero_pool_state[VAL_HOST_ZERO_POOL_PAGES];
+
 /* get vmid */
 uint16_t val_host_get_vmid(void)
 {
@@ -42,6 +58,27 @@ void *mem_alloc(size_t alignment, size_t size)
 {
     uint64_t addr;
 
+    if (heap_persist)
+    {
+        if ((heap_top - heap_base) < size)
+        {
+           LOG(ERROR, "Not enough space available\n");
+           return NULL;
+        }
+
+        addr = ADDR_ALIGN_DOWN(heap_top - size, alignment);
+        if (addr < heap_base)
+        {
+           LOG(ERROR, "Not enough space available\n");
+           return NULL;
+        }
+
+        heap_top = addr;
+        heap_persist_base = addr;
+
+        return (void *)addr;
+    }
+
     addr = ADDR_ALIGN(heap_base, alignment);
     size += addr - heap_base;
 
@@ -64,11 +101,36 @@ void *mem_alloc(size_t alignment, size_t size)
 void val_host_mem_alloc_init(void)
 {
     heap_base = PLATFORM_HEAP_REGION_BASE;
-    heap_top = PLATFORM_HEAP_REGION_BASE + PLATFORM_HEAP_REGION_SIZE;
+    heap_top = heap_persist_base;
     number_of_regions = 0;
     curr_vmid = 0;
 }
 
+/**
+ * @brief  Starts or stops taking allocations from the persistent part of the heap,
+ *         for objects that outlive the test which created them. Only what is
+ *         allocated while enabled survives val_host_mem_alloc_init().
+ * @param  enable - true to allocate persistent memory, false to go back to
+ *                  the per test heap
+ * @return Void
+ **/
+void val_host_mem_alloc_persist(bool enable)
+{
+    heap_persist = enable;
+}
+
+/**
+ * @brief  Returns the persistent allocations to the per test heap from the next
+ *         val_host_mem_alloc_init() onwards.
+ * @param  void
+ * @return Void
+ **/
+void val_host_mem_alloc_persist_release(void)
+{
+    heap_persist = false;
+    heap_persist_base = PLATFORM_HEAP_REGION_BASE + PLATFORM_HEAP_REGION_SIZE;
+}
+
 /**
  * @brief Allocates contiguous memory of requested size(no_of_bytes) and alignment.
  * @param alignment - alignment for the address. It must be in power of 2.
@@ -98,6 +160,85 @@ void *val_host_mem_alloc(size_t alignment, size_t size)
   return addr;
 }
 
+/**
+ * @brief Allocates zero filled contiguous memory of requested size and alignment.
+ *        Single pages come from the pre-zeroed pool while it has some left,
+ *        other requests are zeroed here. Only the granules handed out are
+ *        zeroed, the rest of the heap may still hold granules a failed
+ *        teardown left delegated.
+ * @param alignment - alignment for the address. It must be in power of 2.
+ * @param Size - Size of the region. It must not be zero.
+ * @return - Returns allocated memory base address if allocation is successful.
+ *           Otherwise returns NULL.
+ **/
+void *val_host_mem_alloc_zeroed(size_t alignment, size_t size)
+{
+  void *addr;
+  uint32_t i;
+
+  /* Persistent objects must never go back to the pool at the end of the test */
+  if (!heap_persist && size != 0 && size <= PAGE_SIZE && alignment != 0 &&
+      (PAGE_SIZE % alignment) == 0)
+  {
+    for (i = 0; i < VAL_HOST_ZERO_POOL_PAGES; i++)
+    {
+      if (zero_pool_state[i] == ZERO_POOL_ZERO)
+      {
+        zero_pool_state[i] = ZERO_POOL_USED;
+        return zero_pool[i];
+      }
+    }
+  }
+
+  addr = val_host_mem_alloc(alignment, size);
+  if (!addr)
+    return NULL;
+
+  val_memzero(addr, size);
+
+  return addr;
+}
+
+/**
+ * @brief  Tracks the delegation state of the pre-zeroed pool pages, so that
+ *         a granule still delegated is never written by the refill.
+ * @param  addr      - PA of the granule
+ * @param  delegated - true once delegated, false once undelegated again
+ * @return Void
+ **/
+void val_host_mem_zero_pool_delegate(uint64_t addr, bool delegated)
+{
+  uint64_t base = (uint64_t)zero_pool;
+  uint64_t i;
+
+  if (addr < base || addr >= base + sizeof(zero_pool))
+    return;
+
+  i = (addr - base) / PAGE_SIZE;
+  zero_pool_state[i] = delegated ? ZERO_POOL_DELEGATED : ZERO_POOL_USED;
+}
+
+/**
+ * @brief  Zeroes the pool pages used by the previous test, outside of any
+ *         object setup. Pages that are still delegated stay out of the pool
+ *         until they are undelegated.
+ * @param  void
+ * @return Void
+ **/
+void val_host_mem_zero_pool_refill(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < VAL_HOST_ZERO_POOL_PAGES; i++)
+  {
+    if (zero_pool_state[i] == ZERO_POOL_USED || zero_pool_state[i] == ZERO_POOL_DIRTY)
+    {
+      val_memzero(zero_pool[i], PAGE_SIZE);
+      zero_pool_state[i] = ZERO_POOL_ZERO;
+    }
+  }
+}
+
 /**
  * Free the memory for given memory address
  * Currently acs code is initialisazing from base for every test,
@@ -9,35 +9,26 @@
 #include "val_host_doe.h"
 #include "val_host_pcie_spec.h"
 #include "val_host_pcie.h"
+#include "val_host_rhi.h"
 
-static uint64_t val_host_pdev_doe_communicate(val_host_pdev_ts *pdev_obj,
-                            val_host_dev_comm_enter_ts *dev_comm_enter,
-                              val_host_dev_comm_exit_ts *dev_comm_exit)
+static uint64_t val_host_pdev_doe_complete(val_host_pdev_ts *pdev_obj,
+                            val_host_dev_comm_enter_ts *dev_comm_enter)
 {
-    size_t resp_len;
-    uint64_t rc;
-
-    resp_len = 0UL;
-    rc = val_host_pcie_doe_communicate(pdev_obj->bdf,
-                  pdev_obj->doe_cap_base,
-                  (void *)dev_comm_enter->req_addr,
-                  dev_comm_exit->req_len,
-                  (void *)dev_comm_enter->resp_addr, &resp_len, dev_comm_exit->protocol);
-
     /*
      * Set dev_comm_enter args for next pdev_communicate. Upon
      * success or error call pdev_communicate
      */
-    if (rc == 0) {
+    if (pdev_obj->doe_ctx.state == VAL_HOST_DOE_DONE) {
         dev_comm_enter->status = RMI_DEV_COMM_RESPONSE;
-        dev_comm_enter->resp_len = resp_len;
-    } else {
-        dev_comm_enter->status = RMI_DEV_COMM_ERROR;
-        dev_comm_enter->resp_len = 0;
-        rc = VAL_ERROR;
+        dev_comm_enter->resp_len = pdev_obj->doe_ctx.resp_len;
+        pdev_obj->doe_ctx.state = VAL_HOST_DOE_IDLE;
+        return 0;
     }
 
-    return rc;
+    dev_comm_enter->status = RMI_DEV_COMM_ERROR;
+    dev_comm_enter->resp_len = 0;
+    pdev_obj->doe_ctx.state = VAL_HOST_DOE_IDLE;
+    return VAL_ERROR;
 }
 
 static uint64_t val_host_pdev_cache_device_object(val_host_pdev_ts *pdev_obj,
@@ -172,28 +163,33 @@ static uint64_t val_host_dev_cache_dev_req_resp(val_host_pdev_ts *pdev_obj,
         return VAL_ERROR;
     }
 
-    rc = val_host_dev_cache_dev_object(pdev_obj, vdev_obj,
-                       (uint8_t *)dev_comm_enter->req_addr,
-                       dev_comm_exit->cache_obj_id,
-                       dev_comm_exit->req_cache_offset,
-                       dev_comm_exit->req_cache_len);
+    if (dev_comm_exit->req_cache_len != 0) {
+        rc = val_host_dev_cache_dev_object(pdev_obj, vdev_obj,
+                           (uint8_t *)dev_comm_enter->req_addr,
+                           dev_comm_exit->cache_obj_id,
+                           dev_comm_exit->req_cache_offset,
+                           dev_comm_exit->req_cache_len);
 
-    if (rc != 0) {
-        LOG(ERROR, "host_dev_cache_device_object req failed\n");
-        return VAL_ERROR;
+        if (rc != 0) {
+            LOG(ERROR, "host_dev_cache_device_object req failed\n");
+            return VAL_ERROR;
+        }
     }
 
-    rc = val_host_dev_cache_dev_object(pdev_obj, vdev_obj,
-                       (uint8_t *)dev_comm_enter->resp_addr,
-                       dev_comm_exit->cache_obj_id,
-                       dev_comm_exit->rsp_cache_offset,
-                       dev_comm_exit->rsp_cache_len);
+    if (dev_comm_exit->rsp_cache_len != 0) {
+        rc = val_host_dev_cache_dev_object(pdev_obj, vdev_obj,
+                           (uint8_t *)dev_comm_enter->resp_addr,
+                           dev_comm_exit->cache_obj_id,
+                           dev_comm_exit->rsp_cache_offset,
+                           dev_comm_exit->rsp_cache_len);
 
-    if (rc != 0) {
-        LOG(ERROR, "host_dev_cache_device_object rsp failed\n");
+        if (rc != 0) {
+            LOG(ERROR, "host_dev_cache_device_object rsp failed\n");
+            return VAL_ERROR;
+        }
     }
 
-    return rc;
+    return 0;
 }
 
 static uint64_t val_host_rmi_dev_communicate(val_host_realm_ts *realm, val_host_pdev_ts *pdev_obj,
@@ -262,99 +258,250 @@ static uint64_t val_host_dev_get_state(val_host_pdev_ts *pdev_obj, val_host_vdev
     }
 }
 
-uint64_t val_host_dev_communicate(val_host_realm_ts *realm, val_host_pdev_ts *pdev_obj,
-                             val_host_vdev_ts *vdev_obj, unsigned char target_state)
+/*
+ * Issue one RMI dev communicate call and act on its exit flags. When the RMM
+ * asks for a request to be sent, the DOE exchange is only armed and
+ * *doe_pending is set; the caller progresses it with the DOE engine.
+ */
+static uint64_t val_host_dev_comm_issue(val_host_realm_ts *realm, val_host_pdev_ts *pdev_obj,
+                                        val_host_vdev_ts *vdev_obj, bool *doe_pending)
 {
-    uint64_t rc;
-    uint64_t state;
-    uint64_t error_state;
+    val_host_dev_comm_enter_ts *dev_comm_enter;
+    val_host_dev_comm_exit_ts *dev_comm_exit;
     uint64_t ret;
-    val_host_dev_comm_enter_ts *dev_comm_enter = NULL;
-    val_host_dev_comm_exit_ts *dev_comm_exit = NULL;
-    bool stop;
-    (void)realm;
-    (void)ret;
+    uint64_t rc;
 
-    if (pdev_obj == NULL) {
+    if (vdev_obj) {
+        dev_comm_enter = &vdev_obj->dev_comm_data->enter;
+        dev_comm_exit = &vdev_obj->dev_comm_data->exit;
+    } else {
+        dev_comm_enter = &pdev_obj->dev_comm_data->enter;
+        dev_comm_exit = &pdev_obj->dev_comm_data->exit;
+    }
+
+    *doe_pending = false;
+
+    ret = val_host_rmi_dev_communicate(realm, pdev_obj, vdev_obj);
+    if (ret != RMI_SUCCESS) {
+        LOG(ERROR, "host_rmi_dev_communicate failed\n");
         return VAL_ERROR;
     }
 
+    /*
+     * If cache is set, then the corresponding buffer(s) has the
+     * device object to be cached.
+     */
+    if ((dev_comm_exit->flags & RMI_DEV_COMM_EXIT_FLAGS_REQ_CACHE_BIT) ||
+        (dev_comm_exit->flags & RMI_DEV_COMM_EXIT_FLAGS_RSP_CACHE_BIT))
+    {
+
+        rc = val_host_dev_cache_dev_req_resp(pdev_obj, vdev_obj,
+                           dev_comm_enter, dev_comm_exit);
+        if (rc != 0) {
+            LOG(ERROR, "host_dev_cache_dev_object failed\n");
+            return rc;
+        }
+    }
+
+    /* Send request to PDEV's DOE and get response */
+    if (dev_comm_exit->flags & RMI_DEV_COMM_EXIT_FLAGS_REQ_SEND_BIT) {
+        rc = val_host_doe_start(&pdev_obj->doe_ctx, pdev_obj->bdf,
+                  pdev_obj->doe_cap_base,
+                  (void *)dev_comm_enter->req_addr,
+                  dev_comm_exit->req_len,
+                  (void *)dev_comm_enter->resp_addr, dev_comm_exit->protocol);
+        if (rc != 0) {
+            LOG(ERROR, "val_host_doe_start failed\n");
+            return VAL_ERROR;
+        }
+        *doe_pending = true;
+    } else {
+        dev_comm_enter->status = RMI_DEV_COMM_NONE;
+    }
+
+    return 0;
+}
+
+static uint64_t val_host_dev_comm_check(val_host_pdev_ts *pdev_obj, val_host_vdev_ts *vdev_obj,
+                                        unsigned char target_state, bool *stop)
+{
+    val_host_dev_comm_exit_ts *dev_comm_exit;
+    uint64_t error_state;
+    uint64_t state;
+    uint64_t rc;
+
     if (vdev_obj) {
-        dev_comm_enter = &vdev_obj->dev_comm_data->enter;
         dev_comm_exit = &vdev_obj->dev_comm_data->exit;
-
         error_state = RMI_VDEV_ERROR;
     } else {
-        dev_comm_enter = &pdev_obj->dev_comm_data->enter;
         dev_comm_exit = &pdev_obj->dev_comm_data->exit;
-
         error_state = RMI_PDEV_ERROR;
     }
 
-    dev_comm_enter->status = RMI_DEV_COMM_NONE;
-    dev_comm_enter->resp_len = 0;
+    /*
+     * While the RMM still has a request to send or a response to wait for,
+     * the operation is in flight and the object state cannot settle, so
+     * there is no need to spend a GET_STATE call on it.
+     */
+    if (dev_comm_exit->flags & (RMI_DEV_COMM_EXIT_FLAGS_REQ_SEND_BIT |
+                                RMI_DEV_COMM_EXIT_FLAGS_RSP_WAIT_BIT)) {
+        *stop = false;
+        return 0;
+    }
+
+    *stop = true;
 
     rc = val_host_dev_get_state(pdev_obj, vdev_obj, &state);
     if (rc != 0) {
         return rc;
     }
 
+    if (state == target_state) {
+        /* The target state was reached, but for some
+         * transitions this is not enough, ned to continue
+         * calling it till certain flags are cleared in the
+         * exit. wait for that to happen.
+         */
+        *stop = dev_comm_exit->flags == 0U;
+    } else if (state == error_state) {
+        LOG(ERROR, "Failed to reach target_state, current state: %lu \
+            expected state: instead of %u\n", state, (unsigned int)target_state);
+        return VAL_ERROR;
+    } else {
+        *stop = false;
+    }
+
+    return 0;
+}
+
+uint64_t val_host_dev_communicate(val_host_realm_ts *realm, val_host_pdev_ts *pdev_obj,
+                             val_host_vdev_ts *vdev_obj, unsigned char target_state)
+{
+    uint64_t rc;
+    val_host_dev_comm_enter_ts *dev_comm_enter = NULL;
+    val_host_doe_ctx_ts *doe_ctx[1];
+    bool doe_pending;
+    bool stop;
+
+    if (pdev_obj == NULL) {
+        return VAL_ERROR;
+    }
+
+    if (vdev_obj) {
+        dev_comm_enter = &vdev_obj->dev_comm_data->enter;
+    } else {
+        dev_comm_enter = &pdev_obj->dev_comm_data->enter;
+    }
+
+    dev_comm_enter->status = RMI_DEV_COMM_NONE;
+    dev_comm_enter->resp_len = 0;
+    pdev_obj->doe_ctx.state = VAL_HOST_DOE_IDLE;
+    doe_ctx[0] = &pdev_obj->doe_ctx;
+
     do {
-        ret = val_host_rmi_dev_communicate(realm, pdev_obj, vdev_obj);
-        if (ret != RMI_SUCCESS) {
-            LOG(ERROR, "host_rmi_dev_communicate failed\n");
-            rc = VAL_ERROR;
+        rc = val_host_dev_comm_issue(realm, pdev_obj, vdev_obj, &doe_pending);
+        if (rc != 0) {
             break;
         }
 
-        /*
-         * If cache is set, then the corresponding buffer(s) has the
-         * device object to be cached.
-         */
-        if ((dev_comm_exit->flags & RMI_DEV_COMM_EXIT_FLAGS_REQ_CACHE_BIT) ||
-            (dev_comm_exit->flags & RMI_DEV_COMM_EXIT_FLAGS_RSP_CACHE_BIT))
-        {
+        if (doe_pending) {
+            rc = val_host_doe_wait(doe_ctx, 1);
+            if (rc != VAL_SUCCESS) {
+                LOG(ERROR, "DOE exchange failed for bdf 0x%x\n", pdev_obj->bdf);
+            }
 
-            rc = val_host_dev_cache_dev_req_resp(pdev_obj, vdev_obj,
-                               dev_comm_enter, dev_comm_exit);
-            if (rc != 0) {
-                LOG(ERROR, "host_dev_cache_dev_object failed\n");
-                break;
+            if (val_host_pdev_doe_complete(pdev_obj, dev_comm_enter) != 0) {
+                rc = VAL_ERROR;
             }
-        }
 
-        /* Send request to PDEV's DOE and get response */
-        if (dev_comm_exit->flags & RMI_DEV_COMM_EXIT_FLAGS_REQ_SEND_BIT) {
-            rc = val_host_pdev_doe_communicate(pdev_obj, dev_comm_enter,
-                               dev_comm_exit);
             if (rc != 0) {
                 LOG(ERROR, "val_host_pdev_doe_communicate failed\n");
                 break;
             }
-        } else {
-            dev_comm_enter->status = RMI_DEV_COMM_NONE;
         }
 
-        rc = val_host_dev_get_state(pdev_obj, vdev_obj, &state);
-        if (rc != 0) {
-            break;
+        rc = val_host_dev_comm_check(pdev_obj, vdev_obj, target_state, &stop);
+    } while ((rc == 0) && !stop);
+
+    return rc;
+}
+
+/**
+  @brief   Drives several PDEVs to the same target state, interleaving their
+           SPDM exchanges. A PDEV whose DOE response is not ready yet is skipped
+           and the remaining PDEVs are progressed, so multi-device setups are
+           not serialised behind the slowest device.
+  @param   pdev_objs    - list of PDEV objects
+  @param   count        - number of PDEV objects in the list
+  @param   target_state - PDEV state to reach
+
+  @return  0 if all PDEVs reached target_state, VAL_ERROR otherwise
+**/
+uint64_t val_host_pdevs_communicate(val_host_pdev_ts **pdev_objs, uint32_t count,
+                                    unsigned char target_state)
+{
+    val_host_pdev_ts *pdev_obj;
+    uint64_t stopped = 0, pending = 0;
+    uint64_t rc = 0;
+    uint32_t i, remaining;
+    bool doe_pending;
+    bool stop;
+
+    if ((pdev_objs == NULL) || (count > VAL_HOST_DOE_MAX_INFLIGHT)) {
+        return VAL_ERROR;
+    }
+
+    for (i = 0; i < count; i++) {
+        pdev_obj = pdev_objs[i];
+        if ((pdev_obj == NULL) || (pdev_obj->dev_comm_data == NULL)) {
+            return VAL_ERROR;
         }
-        if (state == target_state) {
-            /* The target state was reached, but for some
-             * transitions this is not enough, ned to continue
-             * calling it till certain flags are cleared in the
-             * exit. wait for that to happen.
-             */
-            stop = dev_comm_exit->flags == 0U;
-        } else if (state == error_state) {
-            LOG(ERROR, "Failed to reach target_state, current state: %lu \
-                expected state: instead of %u\n", state, (unsigned int)target_state);
-            rc = VAL_ERROR;
-            stop = true;
-        } else {
+
+        pdev_obj->dev_comm_data->enter.status = RMI_DEV_COMM_NONE;
+        pdev_obj->dev_comm_data->enter.resp_len = 0;
+        pdev_obj->doe_ctx.state = VAL_HOST_DOE_IDLE;
+    }
+
+    remaining = count;
+    while (remaining) {
+        for (i = 0; i < count; i++) {
+            if (stopped & (1ULL << i)) {
+                continue;
+            }
+
+            pdev_obj = pdev_objs[i];
             stop = false;
+
+            if (pending & (1ULL << i)) {
+                /* Response not ready yet, move on to the next PDEV */
+                (void)val_host_doe_poll(&pdev_obj->doe_ctx);
+                if (VAL_HOST_DOE_IN_FLIGHT(&pdev_obj->doe_ctx)) {
+                    continue;
+                }
+
+                pending &= ~(1ULL << i);
+                if (val_host_pdev_doe_complete(pdev_obj, &pdev_obj->dev_comm_data->enter) ||
+                    val_host_dev_comm_check(pdev_obj, NULL, target_state, &stop)) {
+                    LOG(ERROR, "PDEV communicate failed for bdf 0x%x\n", pdev_obj->bdf);
+                    rc = VAL_ERROR;
+                    stop = true;
+                }
+            } else if (val_host_dev_comm_issue(NULL, pdev_obj, NULL, &doe_pending)) {
+                rc = VAL_ERROR;
+                stop = true;
+            } else if (doe_pending) {
+                pending |= (1ULL << i);
+            } else if (val_host_dev_comm_check(pdev_obj, NULL, target_state, &stop)) {
+                rc = VAL_ERROR;
+                stop = true;
+            }
+
+            if (stop) {
+                stopped |= (1ULL << i);
+                remaining--;
+            }
         }
-    } while (!stop);
+    }
 
     return rc;
 }
@@ -471,6 +618,13 @@ uint32_t val_host_pdev_teardown(val_host_pdev_ts *pdev_obj, uint64_t pdev_ptr)
         return VAL_ERROR;
     }
 
+    /* The shared PDEV outlives the test, callers leave it to da_release_shared_pdev() */
+    if (da_pdev_is_shared(pdev_ptr)) {
+        LOG(ERROR, "PDEV 0x%lx is shared across tests and is not torn down here\n",
+            (unsigned long)pdev_ptr);
+        return VAL_ERROR;
+    }
+
     args = val_host_rmi_pdev_get_state(pdev_ptr);
     if (args.x0) {
         LOG(ERROR, "PDEV get state failed during teardown, ret=0x%lx\n",
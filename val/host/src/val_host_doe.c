@@ -7,21 +7,23 @@
 
 #include "val_host_pcie.h"
 #include "val_host_doe.h"
+#include "val_timer.h"
 
 uint64_t val_host_pcie_doe_communicate(uint32_t bdf, uint32_t doe_cap_base,
              void *req_buf, size_t req_sz, void *rsp_buf, size_t *rsp_sz, uint8_t req_type)
 {
+    val_host_doe_ctx_ts ctx = {0};
+    val_host_doe_ctx_ts *ctx_list[1] = {&ctx};
     uint64_t rc;
 
-    rc = val_host_pcie_doe_send_req(bdf, doe_cap_base,
-                   (uint32_t *)req_buf, (uint32_t)req_sz, req_type);
+    rc = val_host_doe_start(&ctx, bdf, doe_cap_base, req_buf, req_sz, rsp_buf, req_type);
     if (rc != 0) {
         LOG(ERROR, "PCIe DOE %s failed %d\n", "Request", rc);
         return rc;
     }
 
-    rc = val_host_pcie_doe_recv_resp(bdf, doe_cap_base, (uint32_t *)rsp_buf,
-                rsp_sz);
+    rc = val_host_doe_wait(ctx_list, 1);
+    *rsp_sz = ctx.resp_len;
     return rc;
 }
 
@@ -47,7 +49,6 @@ uint32_t val_host_pcie_doe_send_req(uint32_t bdf, uint32_t doe_cap_base, uint32_
         return VAL_ERROR;
     }
 
-    val_pcie_read_cfg(bdf, doe_cap_base + DOE_STATUS_REG, &value);
     if (VAL_EXTRACT_BITS(value, DOE_STATUS_REG_ERROR, DOE_STATUS_REG_ERROR))
     {
         LOG(ERROR, "DOE Error bit is set\n");
@@ -70,7 +71,7 @@ uint32_t val_host_pcie_doe_send_req(uint32_t bdf, uint32_t doe_cap_base, uint32_
     }
 
     /*Set Go bit*/
-    val_pcie_write_cfg(bdf, doe_cap_base + DOE_CTRL_REG, (uint32_t)(1 << 31));
+    val_pcie_write_cfg(bdf, doe_cap_base + DOE_CTRL_REG, VAL_HOST_DOE_CTRL_GO);
     return VAL_SUCCESS;
 }
 
@@ -96,8 +97,6 @@ uint32_t val_host_pcie_doe_recv_resp(uint32_t bdf, uint32_t doe_cap_base, uint32
         return VAL_ERROR;
     }
 
-    val_pcie_read_cfg(bdf, doe_cap_base + DOE_STATUS_REG, &value);
-
     if (VAL_EXTRACT_BITS(value, DOE_STATUS_REG_ERROR, DOE_STATUS_REG_ERROR))
     {
         LOG(ERROR, "DOE Error bit is set\n");
@@ -112,6 +111,12 @@ uint32_t val_host_pcie_doe_recv_resp(uint32_t bdf, uint32_t doe_cap_base, uint32
     val_pcie_read_cfg(bdf, doe_cap_base + DOE_READ_DATA_MAILBOX_REG, &value);
     val_pcie_write_cfg(bdf, doe_cap_base + DOE_READ_DATA_MAILBOX_REG, 0);
 
+    if (value < VAL_HOST_DOE_HEADER_LENGTH)
+    {
+        LOG(ERROR, "DOE response length is invalid: %x\n", value);
+        return VAL_ERROR;
+    }
+
     length = value - VAL_HOST_DOE_HEADER_LENGTH;
     *resp_len = (uint64_t)length * 4;
 
@@ -131,3 +136,186 @@ uint32_t val_host_pcie_doe_recv_resp(uint32_t bdf, uint32_t doe_cap_base, uint32
 
     return VAL_SUCCESS;
 }
+
+/**
+  @brief   Returns the system counter value at which a DOE step started now times out.
+  @param   none
+
+  @return  deadline in system counter ticks
+**/
+static uint64_t val_host_doe_deadline(void)
+{
+    return val_read_cntpct_el0() +
+           ((val_read_cntfrq_el0() * VAL_HOST_DOE_TIMEOUT_MS) / 1000U);
+}
+
+/**
+  @brief   This API arms a DOE exchange on a context without touching the mailbox.
+           The exchange is progressed by val_host_doe_poll().
+  @param   ctx    - DOE exchange context, must not have an exchange in flight
+  @param   bdf    - concatenated Bus(8-bits), device(8-bits) & function(8-bits)
+  @param   doe_cap_base - DOE capability base offset
+  @param   req_buf  - DOE request payload buffer
+  @param   req_sz  - DOE request payload length
+  @param   rsp_buf  - DOE response payload buffer
+  @param   req_type  - DOE data object type
+
+  @return  success/failure
+**/
+uint32_t val_host_doe_start(val_host_doe_ctx_ts *ctx, uint32_t bdf, uint32_t doe_cap_base,
+                     void *req_buf, size_t req_sz, void *rsp_buf, uint8_t req_type)
+{
+    if ((ctx == NULL) || (req_buf == NULL) || (rsp_buf == NULL))
+    {
+        return VAL_ERROR;
+    }
+
+    if (VAL_HOST_DOE_IN_FLIGHT(ctx))
+    {
+        LOG(ERROR, "DOE exchange already in flight for bdf 0x%x\n", ctx->bdf);
+        return VAL_ERROR;
+    }
+
+    ctx->bdf = bdf;
+    ctx->doe_cap_base = doe_cap_base;
+    ctx->req_type = req_type;
+    ctx->req_addr = (uint32_t *)req_buf;
+    ctx->req_len = (uint64_t)req_sz;
+    ctx->resp_addr = (uint32_t *)rsp_buf;
+    ctx->resp_len = 0;
+    ctx->deadline = val_host_doe_deadline();
+    ctx->state = VAL_HOST_DOE_SENDING;
+
+    return VAL_SUCCESS;
+}
+
+/**
+  @brief   Fails a DOE exchange and aborts the mailbox, which clears BUSY and ERROR
+           so that the next exchange on it can start.
+  @param   ctx    - DOE exchange context
+
+  @return  VAL_HOST_DOE_ERROR
+**/
+static val_host_doe_state_te val_host_doe_fail(val_host_doe_ctx_ts *ctx)
+{
+    val_pcie_write_cfg(ctx->bdf, ctx->doe_cap_base + DOE_CTRL_REG, VAL_HOST_DOE_CTRL_ABORT);
+    ctx->state = VAL_HOST_DOE_ERROR;
+    return ctx->state;
+}
+
+/**
+  @brief   This API advances a DOE exchange by at most one state without blocking.
+           SENDING waits for BUSY to clear and writes the request, WAITING waits
+           for READY and RECEIVING drains the response object.
+  @param   ctx    - DOE exchange context
+
+  @return  state of the exchange after the step
+**/
+val_host_doe_state_te val_host_doe_poll(val_host_doe_ctx_ts *ctx)
+{
+    uint32_t value;
+
+    if (!VAL_HOST_DOE_IN_FLIGHT(ctx))
+    {
+        return ctx->state;
+    }
+
+    val_pcie_read_cfg(ctx->bdf, ctx->doe_cap_base + DOE_STATUS_REG, &value);
+
+    if (VAL_EXTRACT_BITS(value, DOE_STATUS_REG_ERROR, DOE_STATUS_REG_ERROR))
+    {
+        LOG(ERROR, "DOE Error bit is set for bdf 0x%x\n", ctx->bdf);
+        return val_host_doe_fail(ctx);
+    }
+
+    switch (ctx->state)
+    {
+        case VAL_HOST_DOE_SENDING:
+            if (VAL_EXTRACT_BITS(value, DOE_STATUS_REG_BUSY, DOE_STATUS_REG_BUSY))
+            {
+                break;
+            }
+
+            if (val_host_pcie_doe_send_req(ctx->bdf, ctx->doe_cap_base, ctx->req_addr,
+                                           ctx->req_len, ctx->req_type))
+            {
+                return val_host_doe_fail(ctx);
+            }
+
+            ctx->deadline = val_host_doe_deadline();
+            ctx->state = VAL_HOST_DOE_WAITING;
+            return ctx->state;
+
+        case VAL_HOST_DOE_WAITING:
+            if (!VAL_EXTRACT_BITS(value, DOE_STATUS_REG_READY, DOE_STATUS_REG_READY))
+            {
+                break;
+            }
+
+            ctx->state = VAL_HOST_DOE_RECEIVING;
+            /* fall through */
+
+        case VAL_HOST_DOE_RECEIVING:
+            if (val_host_pcie_doe_recv_resp(ctx->bdf, ctx->doe_cap_base, ctx->resp_addr,
+                                            &ctx->resp_len))
+            {
+                return val_host_doe_fail(ctx);
+            }
+
+            ctx->state = VAL_HOST_DOE_DONE;
+            return ctx->state;
+
+        default:
+            return ctx->state;
+    }
+
+    if (val_read_cntpct_el0() > ctx->deadline)
+    {
+        LOG(ERROR, "DOE timeout for bdf 0x%x in state %d, status: %x\n",
+                                        ctx->bdf, ctx->state, value);
+        return val_host_doe_fail(ctx);
+    }
+
+    return ctx->state;
+}
+
+/**
+  @brief   This API round-robins over a set of DOE exchanges until all of them
+           complete, so a slow device does not serialise the others.
+  @param   ctx    - list of DOE exchange contexts
+  @param   count  - number of contexts in the list
+
+  @return  VAL_SUCCESS if all exchanges completed, VAL_ERROR otherwise
+**/
+uint32_t val_host_doe_wait(val_host_doe_ctx_ts **ctx, uint32_t count)
+{
+    uint32_t i, pending;
+    uint32_t rc = VAL_SUCCESS;
+
+    if ((ctx == NULL) || (count > VAL_HOST_DOE_MAX_INFLIGHT))
+    {
+        return VAL_ERROR;
+    }
+
+    do {
+        pending = 0;
+        for (i = 0; i < count; i++)
+        {
+            if (VAL_HOST_DOE_IN_FLIGHT(ctx[i]))
+            {
+                val_host_doe_poll(ctx[i]);
+                pending += VAL_HOST_DOE_IN_FLIGHT(ctx[i]) ? 1U : 0U;
+            }
+        }
+    } while (pending);
+
+    for (i = 0; i < count; i++)
+    {
+        if (ctx[i]->state == VAL_HOST_DOE_ERROR)
+        {
+            rc = VAL_ERROR;
+        }
+    }
+
+    return rc;
+}
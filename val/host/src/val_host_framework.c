@@ -13,6 +13,7 @@
 #include "val.h"
 #include "val_host_memory.h"
 #include "pal_common_support.h"
+#include "val_host_rhi.h"
 
 extern const uint32_t  total_tests;
 extern const test_db_t test_list[];
@@ -69,6 +70,198 @@ void val_host_set_reboot_flag(void)
    }
 }
 
+/* NVM offset of the timing slot of a test, slot 0 holds the running test start */
+#define TEST_TIMING_SLOT(test_num) \
+    (uint32_t)(PLATFORM_NVM_TEST_TIMING_OFFSET + (((test_num) + 1U) * sizeof(val_host_test_time_ts)))
+
+#define TEST_TIMING_SLOT_VALID(test_num) \
+    ((((test_num) + 2U) * sizeof(val_host_test_time_ts)) <= PLATFORM_NVM_TEST_TIMING_SIZE)
+
+/**
+ *   @brief    Clears the per test durations on a power on reset
+ *   @param    void
+ *   @return   SUCCESS/FAILURE
+**/
+static uint32_t val_host_test_timing_clear(void)
+{
+    val_host_test_time_ts zero = {0};
+    uint32_t test_num;
+
+    if (val_nvm_write(PLATFORM_NVM_TEST_TIMING_OFFSET, &zero, sizeof(zero)))
+        return VAL_ERROR;
+
+    for (test_num = 0; (test_num < total_tests) && TEST_TIMING_SLOT_VALID(test_num); test_num++)
+    {
+        if (val_nvm_write(TEST_TIMING_SLOT(test_num), &zero, sizeof(zero)))
+            return VAL_ERROR;
+    }
+
+    return VAL_SUCCESS;
+}
+
+/* PMU state found before the cycle counter was started for the running test */
+static struct {
+    bool saved;
+    uint64_t pmcr;
+    uint64_t pmcntenset;
+    uint64_t pmccfiltr;
+} g_test_timing_pmu;
+
+/**
+ *   @brief    Checks for an architected PMU, without which the PMU registers UNDEF
+ *   @param    void
+ *   @return   true if the cycle counter can be used
+**/
+static bool val_host_test_timing_pmu_present(void)
+{
+    uint64_t pmuver = VAL_EXTRACT_BITS(read_id_aa64dfr0_el1(), ID_AA64DFR0_EL1_PMUVer_SHIFT,
+                        ID_AA64DFR0_EL1_PMUVer_SHIFT + ID_AA64DFR0_EL1_PMUVer_WIDTH - 1);
+
+    /* 0xF is an IMPLEMENTATION DEFINED, non architected, PMU */
+    return (pmuver != 0x0) && (pmuver != 0xF);
+}
+
+/**
+ *   @brief    Records the start of a test in NVM and starts the host cycle counter
+ *   @param    void
+ *   @return   void
+**/
+static void val_host_test_timing_start(void)
+{
+    val_host_test_time_ts start = {0};
+
+    g_test_timing_pmu.saved = val_host_test_timing_pmu_present();
+    if (g_test_timing_pmu.saved)
+    {
+        g_test_timing_pmu.pmcr = read_pmcr_el0();
+        g_test_timing_pmu.pmcntenset = read_pmcntenset_el0();
+        g_test_timing_pmu.pmccfiltr = read_pmccfiltr_el0();
+
+        /* Count cycles at NS EL2 as well, the host runs there */
+        write_pmccfiltr_el0(PMCCFILTR_EL0_NSH_BIT);
+        write_pmcntenset_el0(PMCNTENSET_EL0_C_BIT);
+        write_pmcr_el0(g_test_timing_pmu.pmcr | PMCR_EL0_E_BIT);
+        isb();
+
+        start.cycles = read_pmccntr_el0();
+    }
+
+    start.ticks = syscounter_read();
+
+    if (val_nvm_write(PLATFORM_NVM_TEST_TIMING_OFFSET, &start, sizeof(start)))
+        LOG(WARN, "Unable to record test start time\n");
+}
+
+/**
+ *   @brief    Stores the duration of a test in its NVM slot, and gives the PMU
+ *             back in the state the test timing found it
+ *   @param    test_num     -   Test number
+ *   @param    reset_run    -   The test was interrupted by a reset, the cycle
+ *                              counter did not survive it
+ *   @return   void
+**/
+static void val_host_test_timing_stop(uint32_t test_num, bool reset_run)
+{
+    val_host_test_time_ts start, duration = {0};
+    uint64_t ticks = syscounter_read();
+    uint64_t cycles = 0;
+    bool counted = !reset_run && g_test_timing_pmu.saved;
+
+    if (counted)
+    {
+        cycles = read_pmccntr_el0();
+
+        write_pmcr_el0(g_test_timing_pmu.pmcr);
+        if ((g_test_timing_pmu.pmcntenset & PMCNTENSET_EL0_C_BIT) == 0)
+            write_pmcntenclr_el0(PMCNTENSET_EL0_C_BIT);
+        write_pmccfiltr_el0(g_test_timing_pmu.pmccfiltr);
+        isb();
+    }
+    g_test_timing_pmu.saved = false;
+
+    if (!TEST_TIMING_SLOT_VALID(test_num))
+        return;
+
+    if (val_nvm_read(PLATFORM_NVM_TEST_TIMING_OFFSET, &start, sizeof(start)))
+        return;
+
+    if (start.ticks != 0 && ticks > start.ticks)
+        duration.ticks = ticks - start.ticks;
+
+    /* Cycles stay 0 without a PMU */
+    if (counted)
+        duration.cycles = cycles - start.cycles;
+
+    if (val_nvm_write(TEST_TIMING_SLOT(test_num), &duration, sizeof(duration)))
+        LOG(WARN, "Unable to record test duration\n");
+}
+
+/**
+ *   @brief    Prints the slowest tests of the regression
+ *   @param    test_num_start   -   First test number of the regression
+ *   @param    test_num_end     -   Last test number of the regression
+ *   @return   void
+**/
+static void val_host_print_test_timing_report(uint32_t test_num_start, uint32_t test_num_end)
+{
+    val_host_test_time_ts top[VAL_TEST_TIMING_TOP_N] = {0};
+    uint32_t top_num[VAL_TEST_TIMING_TOP_N] = {0};
+    val_host_test_time_ts duration;
+    uint64_t freq = read_cntfrq_el0();
+    uint32_t test_num, n = 0, j;
+
+    for (test_num = test_num_start; (test_num <= test_num_end) && (test_num < total_tests) &&
+                                    TEST_TIMING_SLOT_VALID(test_num); test_num++)
+    {
+        if (val_nvm_read(TEST_TIMING_SLOT(test_num), &duration, sizeof(duration)) ||
+            (duration.ticks == 0))
+            continue;
+
+        /* Insertion into the table kept sorted by decreasing duration */
+        if ((n == VAL_TEST_TIMING_TOP_N) && (duration.ticks <= top[n - 1].ticks))
+            continue;
+
+        if (n < VAL_TEST_TIMING_TOP_N)
+            n++;
+
+        for (j = n - 1; (j > 0) && (top[j - 1].ticks < duration.ticks); j--)
+        {
+            top[j] = top[j - 1];
+            top_num[j] = top_num[j - 1];
+        }
+
+        top[j] = duration;
+        top_num[j] = test_num;
+    }
+
+    if (n == 0)
+        return;
+
+    LOG(ALWAYS, "\n     Slowest tests:\n");
+    LOG(ALWAYS, "     Time(ms)   Host cycles    Test\n");
+    for (j = 0; j < n; j++)
+    {
+        LOG(ALWAYS, "     %-10lu %-14lu %s%s\n", (top[j].ticks * 1000U) / freq, top[j].cycles,
+            test_list[top_num[j]].suite_name, test_list[top_num[j]].test_name);
+    }
+}
+
+/**
+ *   @brief    Reads the shard of the dispatch plan this image has to run
+ *   @param    shard    -   Shard selection, a single shard if none was preloaded
+ *   @return   void
+**/
+static void val_host_get_test_shard(val_host_test_shard_ts *shard)
+{
+    if (val_nvm_read(PLATFORM_NVM_TEST_SHARD_OFFSET, shard, sizeof(*shard)) ||
+        (shard->magic != VAL_TEST_SHARD_MAGIC) || (shard->shard_count == 0) ||
+        (shard->shard_index >= shard->shard_count))
+    {
+        shard->shard_index = 0;
+        shard->shard_count = 1;
+    }
+}
+
 /**
  *   @brief    This function returns the last run test information
  *   @param    test_info    -   Test information structure pointer
@@ -126,6 +319,8 @@ uint32_t val_host_get_last_run_test_info(test_info_t *test_info)
          if (val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_ERROR_INDEX),
                  &regre_report.total_error, sizeof(uint32_t)))
              return VAL_ERROR;
+         if (val_host_test_timing_clear())
+             return VAL_ERROR;
     }
 
     val_log_final_test_status(test_info, &regre_report);
@@ -178,6 +373,9 @@ static void val_host_test_init(uint32_t test_num)
 
    /* Reset mem alloc data structure */
    val_host_mem_alloc_init();
+
+   /* Zero the pool pages used by the previous test before any object setup */
+   val_host_mem_zero_pool_refill();
 }
 
 /**
@@ -245,9 +443,11 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
     test_fptr_t       fn_ptr;
     test_info_t       test_info = {0};
     regre_report_t    regre_report = {0};
+    val_host_test_shard_ts shard;
 
     if (primary_cpu_boot == true)
     {
+        val_host_get_test_shard(&shard);
 
         if (val_host_get_last_run_test_info(&test_info))
         {
@@ -258,6 +458,9 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
         if (test_info.test_num == VAL_INVALID_TEST_NUM)
         {
            val_host_print_acs_header();
+           if (shard.shard_count > 1)
+               LOG(ALWAYS, "Running shard %u of %u\n\n", shard.shard_index + 1U,
+                   shard.shard_count);
            test_info.test_num = 1;
         } else
         {
@@ -357,6 +560,10 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
             if (fn_ptr == NULL)
                 break;
 
+            /* Tests of the other shards run on other model instances */
+            if ((i % shard.shard_count) != shard.shard_index)
+                continue;
+
             /* Skip if RMM do not support planes */
             if ((!feature_planes_supported) && (!val_strcmp((char *)test_list[i].sub_suite_name,
                                                                                      "planes")))
@@ -372,10 +579,17 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
                                                                         "device_assignment")))
                     continue;
 
+#ifdef DA_PDEV_REUSE
+            /* Only rhi tests share the PDEV, other suites create their own */
+            if (val_strcmp((char *)test_list[i].sub_suite_name, "rhi"))
+                da_release_shared_pdev();
+#endif
+
             if (reboot_run)
             {
                 /* Reboot case, find out whether reboot expected or not? */
                 val_handle_reboot_result(test_info.test_progress);
+                val_host_test_timing_stop(i, true);
                 reboot_run = 0;
             } else {
                 if ((val_nvm_write(VAL_NVM_OFFSET(NVM_CUR_TEST_NUM_INDEX),
@@ -385,6 +599,7 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
                     return;
                 }
 
+                val_host_test_timing_start();
                 val_host_test_init(i);
 
                 *(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET) = 0xffffffffffffffff;
@@ -394,6 +609,7 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
                 skip_for_val_logs = 0;
 
 	            val_host_test_exit();
+                val_host_test_timing_stop(i, false);
             }
 
             test_result = val_report_status();
@@ -428,8 +644,13 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
             }
         }
 
+#ifdef DA_PDEV_REUSE
+        da_release_shared_pdev();
+#endif
+
         /* Print Regression report */
         val_print_regression_report(&regre_report);
+        val_host_print_test_timing_report(test_num_start, test_num_end);
     } else {
         /* Resume the current test for secondary cpu */
         fn_ptr = (test_fptr_t)(test_list[val_get_curr_test_num()].host_fn);
@@ -444,7 +665,8 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
 }
 
 /**
- *   @brief    Create PCIe table and PCI enumeration
+ *   @brief    Create PCIe table and PCI enumeration. On a warm reset the
+ *             enumeration saved in NVM is restored instead.
  *   @param    void
  *   @return   void
 **/
@@ -452,8 +674,16 @@ void val_host_create_pcie_info_table(void)
 {
     __attribute__((aligned (PAGE_SIZE))) static uint64_t PcieInfoTable[(sizeof(PCIE_INFO_TABLE)
                   + (PLATFORM_OVERRIDE_NUM_ECAM * sizeof(PCIE_INFO_BLOCK)))/8];
+    uint8_t  test_progress_pattern[] = {TEST_START, TEST_END, TEST_FAIL, TEST_REBOOTING};
+    uint32_t test_progress = 0;
+    bool     warm_reset = false;
+
+    if (!val_nvm_read(VAL_NVM_OFFSET(NVM_TEST_PROGRESS_INDEX),
+            &test_progress, sizeof(uint32_t)))
+        warm_reset = is_reboot_run(test_progress, test_progress_pattern,
+                     sizeof(test_progress_pattern)/sizeof(test_progress_pattern[0]));
 
-    val_pcie_create_info_table(PcieInfoTable);
+    val_pcie_create_info_table(PcieInfoTable, warm_reset);
 }
 
 
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "val_host_measurement.h"
+#include "val_libc.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+
+/*
+ * Reference model of the RMM measurement algorithm. The val_host_rmi wrappers
+ * feed every successful measured command into it, so the expected RIM of each
+ * Realm is available without re-deriving it from the command history.
+ */
+static val_host_meas_ts g_meas[VAL_HOST_MAX_REALMS];
+
+/**
+ * @brief Hash a buffer with the measurement algorithm of a Realm.
+ * @param meas   - Realm measurements
+ * @param buf    - Input buffer
+ * @param len    - Input size
+ * @param out    - Output of VAL_HOST_MEAS_MAX_SIZE bytes, zero padded
+ * @return Returns VAL_SUCCESS or VAL_ERROR
+ **/
+static uint32_t val_host_meas_hash(const val_host_meas_ts *meas, const void *buf,
+                                   size_t len, uint8_t *out)
+{
+    uint8_t digest[VAL_HOST_MEAS_MAX_SIZE] = {0};
+    int rc;
+
+    switch (meas->hash_algo)
+    {
+        case RMI_HASH_SHA_256:
+            rc = mbedtls_sha256(buf, len, digest, 0);
+            break;
+        case RMI_HASH_SHA_384:
+            rc = mbedtls_sha512(buf, len, digest, 1);
+            break;
+        case RMI_HASH_SHA_512:
+            rc = mbedtls_sha512(buf, len, digest, 0);
+            break;
+        default:
+            return VAL_ERROR;
+    }
+
+    if (rc)
+        return VAL_ERROR;
+
+    val_memcpy(out, digest, VAL_HOST_MEAS_MAX_SIZE);
+    return VAL_SUCCESS;
+}
+
+/**
+ * @brief Find the measurements of a Realm.
+ * @param rd     - RD of the Realm
+ * @return Returns the measurements, NULL if the Realm is not tracked
+ **/
+static val_host_meas_ts *val_host_meas_find(uint64_t rd)
+{
+    uint32_t i;
+
+    for (i = 0; i < VAL_HOST_MAX_REALMS; i++)
+    {
+        if (g_meas[i].valid && g_meas[i].rd == rd)
+            return &g_meas[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Start tracking a Realm, RIM is the hash of the measured Realm parameters.
+ * @param rd     - RD of the Realm
+ * @param params - Parameters passed to REALM_CREATE
+ * @return None
+ **/
+void val_host_meas_realm_create(uint64_t rd, const val_host_realm_params_ts *params)
+{
+    static val_host_realm_params_ts measured;
+    val_host_meas_ts *meas = val_host_meas_find(rd);
+    uint32_t i;
+
+    for (i = 0; !meas && i < VAL_HOST_MAX_REALMS; i++)
+    {
+        if (!g_meas[i].valid)
+            meas = &g_meas[i];
+    }
+
+    if (!meas)
+    {
+        LOG(WARN, "No free measurement slot for rd=0x%lx\n", rd);
+        return;
+    }
+
+    val_memset(meas, 0, sizeof(*meas));
+    meas->rd = rd;
+    meas->hash_algo = params->hash_algo;
+    meas->size = (params->hash_algo == RMI_HASH_SHA_256) ? 32U :
+                 (params->hash_algo == RMI_HASH_SHA_384) ? 48U : 64U;
+
+    /* Only the attributes which affect Realm behaviour are measured, RPV is not */
+    val_memset(&measured, 0, sizeof(measured));
+    measured.flags = params->flags;
+    measured.s2sz = params->s2sz;
+    measured.sve_vl = params->sve_vl;
+    measured.num_bps = params->num_bps;
+    measured.num_wps = params->num_wps;
+    measured.pmu_num_ctrs = params->pmu_num_ctrs;
+    measured.hash_algo = params->hash_algo;
+    measured.num_aux_planes = params->num_aux_planes;
+
+    meas->valid = (val_host_meas_hash(meas, &measured, sizeof(measured), meas->rim) ==
+                                                                        VAL_SUCCESS);
+}
+
+/**
+ * @brief Stop tracking a Realm.
+ * @param rd     - RD of the Realm
+ * @return None
+ **/
+void val_host_meas_realm_destroy(uint64_t rd)
+{
+    val_host_meas_ts *meas = val_host_meas_find(rd);
+
+    if (meas)
+        meas->valid = false;
+}
+
+/**
+ * @brief Extend RIM with a REC_CREATE descriptor.
+ * @param rd     - RD of the Realm
+ * @param params - Parameters passed to REC_CREATE
+ * @return None
+ **/
+void val_host_meas_rec_create(uint64_t rd, const val_host_rec_params_ts *params)
+{
+    static val_host_rec_params_ts measured;
+    val_host_meas_desc_rec_ts desc;
+    val_host_meas_ts *meas = val_host_meas_find(rd);
+
+    if (!meas)
+        return;
+
+    val_memset(&measured, 0, sizeof(measured));
+    measured.flags = params->flags;
+    measured.pc = params->pc;
+    val_memcpy(measured.gprs, params->gprs, sizeof(measured.gprs));
+
+    val_memset(&desc, 0, sizeof(desc));
+    desc.desc_type = VAL_HOST_MEAS_DESC_REC;
+    desc.len = sizeof(desc);
+    val_memcpy(desc.rim, meas->rim, sizeof(desc.rim));
+
+    if (val_host_meas_hash(meas, &measured, sizeof(measured), desc.content) ||
+        val_host_meas_hash(meas, &desc, sizeof(desc), meas->rim))
+        meas->valid = false;
+}
+
+/**
+ * @brief Extend RIM with a DATA_CREATE descriptor.
+ * @param rd     - RD of the Realm
+ * @param ipa    - IPA of the Data Granule
+ * @param src    - Contents of the Data Granule
+ * @param flags  - DATA_CREATE flags
+ * @return None
+ **/
+void val_host_meas_data_create(uint64_t rd, uint64_t ipa, const void *src, uint64_t flags)
+{
+    val_host_meas_desc_data_ts desc;
+    val_host_meas_ts *meas = val_host_meas_find(rd);
+
+    if (!meas)
+        return;
+
+    val_memset(&desc, 0, sizeof(desc));
+    desc.desc_type = VAL_HOST_MEAS_DESC_DATA;
+    desc.len = sizeof(desc);
+    desc.ipa = ipa;
+    desc.flags = flags;
+    val_memcpy(desc.rim, meas->rim, sizeof(desc.rim));
+
+    /* Unmeasured Granules contribute their IPA with a zero content hash */
+    if (((flags & RMI_MEASURE_CONTENT) &&
+         val_host_meas_hash(meas, src, PAGE_SIZE, desc.content)) ||
+        val_host_meas_hash(meas, &desc, sizeof(desc), meas->rim))
+        meas->valid = false;
+}
+
+/**
+ * @brief Extend RIM with an RTT_INIT_RIPAS descriptor.
+ * @param rd     - RD of the Realm
+ * @param base   - Base of the range
+ * @param top    - Top of the range which was initialised
+ * @return None
+ **/
+void val_host_meas_init_ripas(uint64_t rd, uint64_t base, uint64_t top)
+{
+    val_host_meas_desc_ripas_ts desc;
+    val_host_meas_ts *meas = val_host_meas_find(rd);
+
+    if (!meas)
+        return;
+
+    val_memset(&desc, 0, sizeof(desc));
+    desc.desc_type = VAL_HOST_MEAS_DESC_RIPAS;
+    desc.len = sizeof(desc);
+    desc.base = base;
+    desc.top = top;
+    val_memcpy(desc.rim, meas->rim, sizeof(desc.rim));
+
+    if (val_host_meas_hash(meas, &desc, sizeof(desc), meas->rim))
+        meas->valid = false;
+}
+
+/**
+ * @brief Extend a REM the way RSI_MEASUREMENT_EXTEND does.
+ * @param rd     - RD of the Realm
+ * @param index  - REM index, 1 to VAL_HOST_MEAS_REM_COUNT
+ * @param value  - Extension value
+ * @param size   - Size of the value, at most VAL_HOST_MEAS_MAX_SIZE
+ * @return Returns VAL_SUCCESS or VAL_ERROR
+ **/
+uint32_t val_host_meas_rem_extend(uint64_t rd, uint64_t index, const void *value, uint64_t size)
+{
+    uint8_t buf[2 * VAL_HOST_MEAS_MAX_SIZE];
+    val_host_meas_ts *meas = val_host_meas_find(rd);
+
+    if (!meas || index < 1 || index > VAL_HOST_MEAS_REM_COUNT || size > VAL_HOST_MEAS_MAX_SIZE)
+        return VAL_ERROR;
+
+    /* REM = H(REM || value) */
+    val_memcpy(buf, meas->rem[index - 1], meas->size);
+    val_memcpy(buf + meas->size, value, size);
+
+    return val_host_meas_hash(meas, buf, meas->size + size, meas->rem[index - 1]);
+}
+
+/**
+ * @brief Get the reference measurements of a Realm.
+ * @param rd     - RD of the Realm
+ * @return Returns the measurements, NULL if the Realm is not tracked or a hash failed
+ **/
+const val_host_meas_ts *val_host_meas_get(uint64_t rd)
+{
+    return val_host_meas_find(rd);
+}
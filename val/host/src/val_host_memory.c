@@ -49,12 +49,14 @@ extern uintptr_t __BSS_START__, __BSS_END__;
                                 BSS_START,                      \
                                 (BSS_END - BSS_START),          \
                                 MT_RW_DATA | MT_NS)
-#define MEMORY_POOL MAP_REGION2(                            \
-                                PLATFORM_MEMORY_POOL_BASE,      \
+/*
+ * Mapped with the largest blocks the layout allows, blocks are split on demand
+ * when val_host_update_attributes() changes part of the pool.
+ */
+#define MEMORY_POOL MAP_REGION_FLAT(                            \
                                 PLATFORM_MEMORY_POOL_BASE,      \
                                 PLATFORM_MEMORY_POOL_SIZE,      \
-                                MT_RW_DATA | MT_NS,              \
-                                0x1000)
+                                MT_RW_DATA | MT_NS)
 #define NS_UART MAP_REGION_FLAT(                                \
                                 PLATFORM_NS_UART_BASE,          \
                                 PLATFORM_NS_UART_SIZE,          \
@@ -22,6 +22,7 @@
 #include "val_libc.h"
 
 PCIE_INFO_TABLE *g_pcie_info_table;
+PCIE_CFG_MAP *g_pcie_cfg_map;
 pcie_device_bdf_table *g_pcie_bdf_table;
 __attribute__((aligned (PAGE_SIZE * 2))) pcie_device_bdf_table
                   g_pcie_bdf_table1[PCIE_DEVICE_BDF_TABLE_SZ];
@@ -42,47 +43,16 @@ uint32_t g_pcie_integrated_devices;
 **/
 uint32_t val_pcie_read_cfg(uint32_t bdf, uint32_t offset, uint32_t *data)
 {
-    uint32_t bus     = PCIE_EXTRACT_BDF_BUS(bdf);
-    uint32_t dev     = PCIE_EXTRACT_BDF_DEV(bdf);
-    uint32_t func    = PCIE_EXTRACT_BDF_FUNC(bdf);
-    uint32_t segment = PCIE_EXTRACT_BDF_SEG(bdf);
-    uint32_t cfg_addr;
-    addr_t   ecam_base = 0;
-    uint32_t i = 0;
-
-
-    if ((bus >= PCIE_MAX_BUS) || (dev >= PCIE_MAX_DEV) || (func >= PCIE_MAX_FUNC)) {
-      LOG(ERROR, "       Invalid Bus/Dev/Func  %x", bdf);
-      return PCIE_NO_MAPPING;
-    }
-
-    if (g_pcie_info_table == NULL) {
-        LOG(ERROR, "       Read_PCIe_CFG: PCIE info table is not created");
-        return PCIE_NO_MAPPING;
-    }
+    addr_t cfg_addr = val_pcie_cfg_addr(bdf);
 
-    while (i < val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0))
-    {
-
-        if ((bus >= val_pcie_get_info(PCIE_INFO_START_BUS, i)) &&
-            (bus <= val_pcie_get_info(PCIE_INFO_END_BUS, i)) &&
-            (segment == val_pcie_get_info(PCIE_INFO_SEGMENT, i))) {
-            ecam_base = val_pcie_get_info(PCIE_INFO_ECAM, i);
-            break;
-        }
-        i++;
-    }
+    /* Buses not resolved by the ECAM map take the ECAM block search */
+    if (cfg_addr == 0)
+        cfg_addr = val_pcie_get_bdf_config_addr(bdf);
 
-    if (ecam_base == 0) {
-        LOG(ERROR, "       Read PCIe_CFG: ECAM Base is zero for bdf %x", bdf);
+    if (cfg_addr == 0)
         return PCIE_NO_MAPPING;
-    }
-
-    /* There are 8 functions / device, 32 devices / Bus and each has a 4KB config space */
-    cfg_addr = (bus * PCIE_MAX_DEV * PCIE_MAX_FUNC * 4096) + \
-                (dev * PCIE_MAX_FUNC * 4096) + (func * 4096);
 
-    *data = pal_mmio_read32(ecam_base + cfg_addr + offset);
+    *data = pal_mmio_read32(cfg_addr + offset);
     return 0;
 
 }
@@ -101,47 +71,16 @@ uint32_t val_pcie_read_cfg(uint32_t bdf, uint32_t offset, uint32_t *data)
 void
 val_pcie_write_cfg(uint32_t bdf, uint32_t offset, uint32_t data)
 {
-    uint32_t bus      = PCIE_EXTRACT_BDF_BUS(bdf);
-    uint32_t dev      = PCIE_EXTRACT_BDF_DEV(bdf);
-    uint32_t func     = PCIE_EXTRACT_BDF_FUNC(bdf);
-    uint32_t segment  = PCIE_EXTRACT_BDF_SEG(bdf);
-    uint32_t cfg_addr;
-    addr_t   ecam_base = 0;
-    uint32_t i = 0;
+    addr_t cfg_addr = val_pcie_cfg_addr(bdf);
 
+    /* Buses not resolved by the ECAM map take the ECAM block search */
+    if (cfg_addr == 0)
+        cfg_addr = val_pcie_get_bdf_config_addr(bdf);
 
-    if ((bus >= PCIE_MAX_BUS) || (dev >= PCIE_MAX_DEV) || (func >= PCIE_MAX_FUNC)) {
-      LOG(ERROR, "Invalid Bus/Dev/Func  %x\n", bdf);
-      return;
-    }
-
-    if (g_pcie_info_table == NULL) {
-        LOG(ERROR, "       Write PCIe_CFG: PCIE info table is not created");
+    if (cfg_addr == 0)
         return;
-    }
-
-    while (i < val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0))
-    {
-
-        if ((bus >= val_pcie_get_info(PCIE_INFO_START_BUS, i)) &&
-            (bus <= val_pcie_get_info(PCIE_INFO_END_BUS, i)) &&
-            (segment == val_pcie_get_info(PCIE_INFO_SEGMENT, i))) {
-            ecam_base = val_pcie_get_info(PCIE_INFO_ECAM, i);
-            break;
-        }
-        i++;
-    }
 
-    if (ecam_base == 0) {
-        LOG(ERROR, "       Read PCIe_CFG: ECAM Base is zero ");
-        return;
-    }
-
-    /* There are 8 functions / device, 32 devices / Bus and each has a 4KB config space */
-    cfg_addr = (bus * PCIE_MAX_DEV * PCIE_MAX_FUNC * 4096) + \
-                (dev * PCIE_MAX_FUNC * 4096) + (func * 4096);
-
-    pal_mmio_write32(ecam_base + cfg_addr + offset, data);
+    pal_mmio_write32(cfg_addr + offset, data);
 }
 
 /**
@@ -190,8 +129,12 @@ uint64_t val_pcie_get_bdf_config_addr(uint32_t bdf)
     uint32_t cfg_addr;
     uint32_t num_ecam;
     addr_t   ecam_base = 0;
+    addr_t   map_addr = val_pcie_cfg_addr(bdf);
     uint32_t i = 0;
 
+    if (map_addr != 0)
+        return map_addr;
+
     if ((bus >= PCIE_MAX_BUS) || (dev >= PCIE_MAX_DEV) || (func >= PCIE_MAX_FUNC)) {
       LOG(ERROR, "Invalid Bus/Dev/Func  %x\n", bdf);
       return 0;
@@ -385,10 +328,11 @@ void val_pcie_print_device_info(void)
            1. Caller       -  Application layer.
            2. Prerequisite -  Memory allocated and passed as argument.
   @param   pcie_info_table    Memory address where PCIe Information is populated
+  @param   warm_reset         Restore the enumeration saved in NVM if still valid
 
   @return  Error if Input param is NULL
 **/
-void val_pcie_create_info_table(uint64_t *pcie_info_table)
+void val_pcie_create_info_table(uint64_t *pcie_info_table, bool warm_reset)
 {
     uint32_t num_ecam;
 
@@ -402,6 +346,7 @@ void val_pcie_create_info_table(uint64_t *pcie_info_table)
     g_pcie_bdf_table = (pcie_device_bdf_table *)g_pcie_bdf_table1;
 
     pal_pcie_create_info_table(g_pcie_info_table);
+    g_pcie_cfg_map = pal_pcie_get_cfg_map();
 
     num_ecam = (uint32_t)val_pcie_get_info(PCIE_INFO_NUM_ECAM, 0);
     LOG(TEST, "PCIE_INFO: Number of ECAM regions    :    %ld\n",
@@ -409,7 +354,15 @@ void val_pcie_create_info_table(uint64_t *pcie_info_table)
     if (num_ecam == 0)
         return;
 
-    val_pcie_enumerate();
+    if (warm_reset && (val_pcie_restore_dev_table() == VAL_SUCCESS))
+    {
+        LOG(INFO, " Restored PCIe enumeration from NVM\n");
+    } else {
+        val_pcie_enumerate();
+
+        if (val_pcie_save_dev_table())
+            LOG(WARN, " Unable to save PCIe enumeration to NVM\n");
+    }
 
     /* Create the list of valid Pcie Device Functions */
     if (val_pcie_create_device_bdf_table()) {
@@ -458,7 +411,33 @@ static uint32_t val_pcie_populate_device_rootport(void)
 }
 
 /**
-  @brief   This API creates the device bdf table from enumeration
+  @brief   This API checks whether a function is stored in the device bdf table
+  @param   bdf - Segment/Bus/Dev/Func in PCIE_CREATE_BDF format
+
+  @return  1 if the function is to be stored, 0 otherwise
+**/
+static uint32_t val_pcie_is_bdf_table_candidate(uint32_t bdf)
+{
+    uint32_t cid_offset;
+
+    /* Skip if the device is a host bridge */
+    if (val_pcie_is_host_bridge(bdf))
+        return 0;
+
+    /* Skip if the device is a PCI legacy device */
+    if (val_pcie_find_capability(bdf, PCIE_CAP, CID_PCIECS, &cid_offset) != PCIE_SUCCESS)
+        return 0;
+
+    if (pal_pcie_check_device_valid(bdf))
+        return 0;
+
+    return 1;
+}
+
+/**
+  @brief   This API creates the device bdf table from enumeration. The functions
+           recorded by the enumeration pass are used when available, else all
+           the ECAM regions are probed.
 
   @param   None
 
@@ -475,10 +454,10 @@ uint32_t val_pcie_create_device_bdf_table(void)
     uint32_t dev_index;
     uint32_t func_index;
     uint32_t ecam_index;
+    uint32_t tbl_index;
     uint32_t bdf;
     uint32_t reg_value;
-    uint32_t cid_offset;
-    uint32_t status;
+    PCIE_DEV_TABLE *dev_table;
 
     if (!g_pcie_bdf_table)
     {
@@ -496,48 +475,47 @@ uint32_t val_pcie_create_device_bdf_table(void)
         return 1;
     }
 
-    for (ecam_index = 0; ecam_index < num_ecam; ecam_index++)
+    dev_table = pal_pcie_get_dev_table();
+    if (dev_table->num_entries != 0)
     {
-        /* Derive ecam specific information */
-        seg_num = (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, ecam_index);
-        start_bus = (uint32_t)val_pcie_get_info(PCIE_INFO_START_BUS, ecam_index);
-        end_bus = (uint32_t)val_pcie_get_info(PCIE_INFO_END_BUS, ecam_index);
+        /* Walk the enumerated functions in BDF order */
+        for (tbl_index = 0; tbl_index < dev_table->num_entries; tbl_index++)
+        {
+            bdf = dev_table->device[dev_table->bdf_index[tbl_index]].bdf;
 
-        /* Iterate over all buses, devices and functions in this ecam */
-        for (bus_index = start_bus; bus_index <= end_bus; bus_index++)
+            if (val_pcie_is_bdf_table_candidate(bdf))
+                g_pcie_bdf_table->device[g_pcie_bdf_table->num_entries++].bdf = bdf;
+        }
+    } else {
+        for (ecam_index = 0; ecam_index < num_ecam; ecam_index++)
         {
-            for (dev_index = 0; dev_index < PCIE_MAX_DEV; dev_index++)
+            /* Derive ecam specific information */
+            seg_num = (uint32_t)val_pcie_get_info(PCIE_INFO_SEGMENT, ecam_index);
+            start_bus = (uint32_t)val_pcie_get_info(PCIE_INFO_START_BUS, ecam_index);
+            end_bus = (uint32_t)val_pcie_get_info(PCIE_INFO_END_BUS, ecam_index);
+
+            /* Iterate over all buses, devices and functions in this ecam */
+            for (bus_index = start_bus; bus_index <= end_bus; bus_index++)
             {
-                for (func_index = 0; func_index < PCIE_MAX_FUNC; func_index++)
+                for (dev_index = 0; dev_index < PCIE_MAX_DEV; dev_index++)
                 {
-                    /* Form bdf using seg, bus, device, function numbers */
-                    bdf = PCIE_CREATE_BDF(seg_num, bus_index, dev_index, func_index);
-
-                    /* Probe pcie device Function with this bdf */
-                    if (val_pcie_read_cfg(bdf, TYPE01_VIDR, &reg_value) == PCIE_NO_MAPPING)
+                    for (func_index = 0; func_index < PCIE_MAX_FUNC; func_index++)
                     {
-                        /* Return if there is a bdf mapping issue */
-                        LOG(ERROR, "       BDF 0x%x mapping issue", bdf);
-                        return 1;
-                    }
-
-                    /* Store the Function's BDF if there was a valid response */
-                    if (reg_value != PCIE_UNKNOWN_RESPONSE)
-                    {
-                        /* Skip if the device is a host bridge */
-                        if (val_pcie_is_host_bridge(bdf))
-                            continue;
-
-                        /* Skip if the device is a PCI legacy device */
-                        if (val_pcie_find_capability(bdf, PCIE_CAP,
-                            CID_PCIECS,  &cid_offset) != PCIE_SUCCESS)
-                            continue;
-
-                        status = pal_pcie_check_device_valid(bdf);
-                        if (status)
-                            continue;
+                        /* Form bdf using seg, bus, device, function numbers */
+                        bdf = PCIE_CREATE_BDF(seg_num, bus_index, dev_index, func_index);
+
+                        /* Probe pcie device Function with this bdf */
+                        if (val_pcie_read_cfg(bdf, TYPE01_VIDR, &reg_value) == PCIE_NO_MAPPING)
+                        {
+                            /* Return if there is a bdf mapping issue */
+                            LOG(ERROR, "       BDF 0x%x mapping issue", bdf);
+                            return 1;
+                        }
 
-                        g_pcie_bdf_table->device[g_pcie_bdf_table->num_entries++].bdf = bdf;
+                        /* Store the Function's BDF if there was a valid response */
+                        if ((reg_value != PCIE_UNKNOWN_RESPONSE) &&
+                            val_pcie_is_bdf_table_candidate(bdf))
+                            g_pcie_bdf_table->device[g_pcie_bdf_table->num_entries++].bdf = bdf;
                     }
                 }
             }
@@ -2259,6 +2237,118 @@ uint32_t val_pcie_get_bar(uint32_t bdf, uint32_t offset, uint64_t *addr, uint64_
     return offset;
 }
 
+/**
+  @brief  Computes the topology checksum of the ECAM blocks and the enumerated
+          device table entries (FNV-1a)
+  @param  dev_table - Device table to checksum
+  @return 64-bit checksum
+**/
+static uint64_t val_pcie_topology_checksum(PCIE_DEV_TABLE *dev_table)
+{
+    uint64_t checksum = 0xcbf29ce484222325ULL;
+    uint8_t *data;
+    uint64_t size, i;
+
+    data = (uint8_t *)g_pcie_info_table->block;
+    size = g_pcie_info_table->num_entries * sizeof(PCIE_INFO_BLOCK);
+    for (i = 0; i < size; i++)
+        checksum = (checksum ^ data[i]) * 0x100000001b3ULL;
+
+    data = (uint8_t *)dev_table->device;
+    size = dev_table->num_entries * sizeof(PCIE_DEV_ENTRY);
+    for (i = 0; i < size; i++)
+        checksum = (checksum ^ data[i]) * 0x100000001b3ULL;
+
+    return checksum;
+}
+
+/**
+  @brief  Saves the enumerated device table to NVM so that it can be restored
+          after a warm reset
+  @param  None
+  @return VAL_SUCCESS/VAL_ERROR
+**/
+uint32_t val_pcie_save_dev_table(void)
+{
+    PCIE_DEV_TABLE *dev_table = pal_pcie_get_dev_table();
+    pcie_nvm_table_hdr hdr;
+    uint32_t size;
+
+    size = (uint32_t)(dev_table->num_entries * sizeof(PCIE_DEV_ENTRY));
+    if ((sizeof(hdr) + size) > PLATFORM_NVM_PCIE_TABLE_SIZE)
+        return VAL_ERROR;
+
+    hdr.magic = PCIE_NVM_TABLE_MAGIC;
+    hdr.num_entries = dev_table->num_entries;
+    hdr.checksum = val_pcie_topology_checksum(dev_table);
+
+    if (val_nvm_write(PLATFORM_NVM_PCIE_TABLE_OFFSET + sizeof(hdr),
+                      dev_table->device, size))
+        return VAL_ERROR;
+
+    /* Header is written last so that a partial save is never restored */
+    if (val_nvm_write(PLATFORM_NVM_PCIE_TABLE_OFFSET, &hdr, sizeof(hdr)))
+        return VAL_ERROR;
+
+    return VAL_SUCCESS;
+}
+
+/**
+  @brief  Restores the device table saved in NVM. The saved table is accepted
+          only if its checksum matches and every recorded function still
+          reports the same IDs and programmed BARs.
+  @param  None
+  @return VAL_SUCCESS if restored, VAL_ERROR if enumeration is required
+**/
+uint32_t val_pcie_restore_dev_table(void)
+{
+    PCIE_DEV_TABLE *dev_table = pal_pcie_get_dev_table();
+    PCIE_DEV_ENTRY *entry;
+    pcie_nvm_table_hdr hdr;
+    uint32_t i, bar_index, reg_value;
+
+    if (val_nvm_read(PLATFORM_NVM_PCIE_TABLE_OFFSET, &hdr, sizeof(hdr)))
+        return VAL_ERROR;
+
+    if ((hdr.magic != PCIE_NVM_TABLE_MAGIC) || (hdr.num_entries == 0) ||
+        (hdr.num_entries > PCIE_DEV_TABLE_MAX_ENTRIES))
+        return VAL_ERROR;
+
+    if (val_nvm_read(PLATFORM_NVM_PCIE_TABLE_OFFSET + sizeof(hdr), dev_table->device,
+                     hdr.num_entries * sizeof(PCIE_DEV_ENTRY)))
+        return VAL_ERROR;
+
+    dev_table->num_entries = hdr.num_entries;
+    if (val_pcie_topology_checksum(dev_table) != hdr.checksum)
+        goto invalid;
+
+    /* Confirm the devices still hold the configuration recorded in the table */
+    for (i = 0; i < dev_table->num_entries; i++)
+    {
+        entry = &dev_table->device[i];
+
+        if (val_pcie_read_cfg(entry->bdf, TYPE01_VIDR, &reg_value) || (reg_value != entry->id))
+            goto invalid;
+
+        for (bar_index = 0; bar_index < PCIE_DEV_MAX_BARS; bar_index++)
+        {
+            if (entry->bar_size[bar_index] == 0)
+                continue;
+
+            val_pcie_read_cfg(entry->bdf, BAR0_OFFSET + (bar_index * 4), &reg_value);
+            if ((reg_value & BAR_MASK) != ((uint32_t)entry->bar_base[bar_index] & BAR_MASK))
+                goto invalid;
+        }
+    }
+
+    pal_pcie_enumerate_restore();
+    return VAL_SUCCESS;
+
+invalid:
+    dev_table->num_entries = 0;
+    return VAL_ERROR;
+}
+
 void val_pcie_mem_enable(uint32_t bdf)
 {
     uint32_t com_reg_value;
@@ -9,6 +9,7 @@
 #include "val_host_alloc.h"
 #include "val_host_helpers.h"
 #include "val_host_doe.h"
+#include "val_host_rhi.h"
 #include "val_timer.h"
 
 int current_realm = 1;
@@ -726,14 +727,13 @@ uint32_t val_host_realm_create(val_host_realm_ts *realm)
     }
 
     /* Allocate memory for params */
-    params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    params = val_host_mem_alloc_zeroed(PAGE_SIZE, PAGE_SIZE);
 
     if (params == NULL)
     {
         LOG(ERROR, "Failed to allocate memory for params\n");
         goto undelegate_rtt;
     }
-    val_memset(params, 0, PAGE_SIZE_4K);
 
     /* Populate params */
     params->flags = realm->flags;
@@ -1121,13 +1121,12 @@ uint32_t val_host_rec_create(val_host_realm_ts *realm)
     }
 
     /* Allocate memory for rec_params */
-    rec_params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    rec_params = val_host_mem_alloc_zeroed(PAGE_SIZE, PAGE_SIZE);
     if (rec_params == NULL)
     {
         LOG(ERROR, "Failed to allocate memory for rec_params\n");
         return VAL_ERROR;
     }
-    val_memset(rec_params, 0x0, PAGE_SIZE);
     val_memset(&rec_create_flags, 0, sizeof(rec_create_flags));
 
     /* Populate rec_params */
@@ -1152,13 +1151,12 @@ uint32_t val_host_rec_create(val_host_realm_ts *realm)
 
         rec_params->mpidr = mpidr;
         /* Allocate memory for run object */
-        realm->run[i] = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+        realm->run[i] = (uint64_t)val_host_mem_alloc_zeroed(PAGE_SIZE, PAGE_SIZE);
         if (!realm->run[i])
         {
             LOG(ERROR, "Failed to allocate memory for run[%d]\n", i);
             goto free_rec_params;
         }
-        val_memset((void *)realm->run[i], 0x0, PAGE_SIZE);
 
         /* Allocate and delegate REC */
         realm->rec[i] = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
@@ -2362,6 +2360,8 @@ uint32_t val_host_realm_destroy(uint64_t rd)
     uint64_t top;
     uint64_t i;
 
+    val_host_rhi_realm_release(rd);
+
     /* For each REC - Destroy, undelegate */
     curr_gran = mem_track[current_realm].gran_type.rec;
     while (curr_gran != NULL)
@@ -14,25 +14,45 @@
 #include "val_host_rhi.h"
 #include "val_host_alloc.h"
 
+/* Maximum number of concurrent RHI host sessions across all realms */
+#define RHI_HOST_MAX_SESSIONS       16U
+
+/* Size of the shared slot used for session payloads */
+#define RHI_HOST_IO_WINDOW_SIZE     (TEST_USE_OFFSET2 - TEST_USE_OFFSET1)
+
+#define RHI_HOST_PAYLOAD_PATTERN    0xabcdabcdU
+
+typedef struct rhi_session_io_state {
+    uint64_t proto_state;
+    uint64_t io_len;
+} rhi_session_io_state_ts;
+
 typedef struct rhi_session {
     uint64_t session_id;
     uint64_t proto_state;
     bool id_in_use;
     uint64_t conn_type;
+    /* Realm which opened the session */
+    uint64_t rd;
+    rhi_session_io_state_ts send_state;
+    rhi_session_io_state_ts recv_state;
 } rhi_session_ts;
 
-typedef struct rhi_session_io_state {
-    uint64_t proto_state;
-    uint64_t io_len;
-} rhi_session_io_state_ts;
-
-rhi_session_ts g_rhi_sess;
-static rhi_session_io_state_ts g_rhi_send_state;
-static rhi_session_io_state_ts g_rhi_recv_state;
+static rhi_session_ts g_rhi_sess[RHI_HOST_MAX_SESSIONS];
 
 static uint64_t g_da_next_handle;
 static uint64_t g_fal_offset;
 
+/* FAL streaming window of the Realm which set one up */
+static struct {
+    uint64_t rd;
+    uint64_t ipa;
+    val_rhi_fal_window_ts *win;
+    /* Kept here, the copies in the window can be rewritten by the Realm */
+    uint64_t data_size;
+    uint64_t prod;
+} g_fal_stream;
+
 /**
  * @brief Allocate a new device assignment handle.
  *
@@ -44,24 +64,85 @@ static uint64_t val_da_alloc_handle(void)
     return handle++;
 }
 
+/**
+ * @brief Look up an open RHI session of a Realm by its identifier.
+ *
+ * @param  sess_id       - Session identifier provided by the Realm
+ * @param  rd            - RD of the Realm issuing the call
+ * @return Returns the session entry, or NULL if the identifier is unknown
+ **/
+static rhi_session_ts *val_host_rhi_session_find(uint64_t sess_id, uint64_t rd)
+{
+    uint32_t i;
+
+    if (sess_id == 0)
+        return NULL;
+
+    for (i = 0; i < RHI_HOST_MAX_SESSIONS; i++)
+    {
+        if (g_rhi_sess[i].id_in_use && g_rhi_sess[i].session_id == sess_id &&
+            g_rhi_sess[i].rd == rd)
+            return &g_rhi_sess[i];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Return a session entry to the free pool.
+ *
+ * @param  sess          - Session entry
+ * @return None
+ **/
+static void val_host_rhi_session_free(rhi_session_ts *sess)
+{
+    val_memset(sess, 0, sizeof(*sess));
+    sess->proto_state = RHI_HSS_SESSION_UNCONNECTED;
+}
+
+/**
+ * @brief Check a payload in the shared buffer against the expected pattern.
+ *
+ * The payload is validated where the Realm placed it, no bounce copy is made.
+ *
+ * @param  buf           - Start of the payload
+ * @param  length        - Length of the payload
+ * @return Returns true if the payload matches the pattern
+ **/
+static bool val_host_rhi_payload_valid(const uint8_t *buf, uint64_t length)
+{
+    uint32_t pattern = RHI_HOST_PAYLOAD_PATTERN;
+    uint64_t idx;
+
+    for (idx = 0; idx < length; idx++)
+    {
+        if (buf[idx] != ((uint8_t *)&pattern)[idx % sizeof(pattern)])
+            return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief Handle RHI session open command from the Realm.
  *
- * Validates the session state and connection type, updates session tracking
- * state, and returns the session identifiers back to the Realm.
+ * An initial call with SessionID 0 allocates a new entry in the session table,
+ * so a Realm can hold several sessions at the same time. Retries of a
+ * non-blocking open pass the SessionID returned by the initial call.
  *
  * @param  sess_id       - Session identifier provided by the Realm
  * @param  conn_type     - Requested connection mode
- * @param  realm         - Realm structure
+ * @param  rd            - RD of the Realm issuing the call
+ * @param  rec_enter     - REC entry structure of the calling REC
  * @return Returns RHI session status code
  **/
 static uint64_t val_host_rhi_session_open(uint64_t sess_id,
                                           uint64_t conn_type,
-                                          val_host_realm_ts *realm)
+                                          uint64_t rd,
+                                          val_host_rec_enter_ts *rec_enter)
 {
-    val_host_rec_enter_ts *rec_enter = NULL;
-
-    rec_enter = &(((val_host_rec_run_ts *)realm->run[0])->enter);
+    rhi_session_ts *sess = NULL;
+    uint32_t i;
 
     LOG(ALWAYS, "session_open: id: %lx conn type: %lx\n", sess_id, conn_type);
 
@@ -73,80 +154,58 @@ static uint64_t val_host_rhi_session_open(uint64_t sess_id,
     if ((conn_type & RHI_CONN_MODE_SUPPORTED_MASK) == RHI_CONN_MODE_SUPPORTED_MASK)
         return RHI_SESS_CONNECTION_TYPE_NOT_SUPPORTED;
 
-    /* -------- BLOCKING -------- */
-    if (conn_type == RHI_CONN_MODE_BLOCKING) {
-
-        /* Invalid unless state is UNCONNECTED */
-        if (g_rhi_sess.proto_state != RHI_HSS_SESSION_UNCONNECTED)
-            return RHI_SESS_INVALID_STATE_FOR_OPERATION;
-
-        /* Initial call rule: SessionID must be 0 */
-        if (sess_id != 0 || g_rhi_sess.id_in_use)
+    if (sess_id != 0) {
+        sess = val_host_rhi_session_find(sess_id, rd);
+        if (!sess)
             return RHI_SESS_INVALID_SESSION_ID;
 
-        /* Success */
-        g_rhi_sess.session_id  = pal_rhi_alloc_session_id();
-        g_rhi_sess.id_in_use   = true;
-        g_rhi_sess.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
-        g_rhi_sess.conn_type = conn_type;
-        g_rhi_send_state.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
-        g_rhi_send_state.io_len = 0;
-        g_rhi_recv_state.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
-        g_rhi_recv_state.io_len = 0;
-
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
-        rec_enter->gprs[2] = g_rhi_sess.proto_state;
-
-        return RHI_SESS_SUCCESS;
-    }
-
-    /* -------- NON-BLOCKING -------- */
-    if (conn_type == RHI_CONN_MODE_NON_BLOCKING) {
-
-        /* Initial call: state UNCONNECTED */
-        if (g_rhi_sess.proto_state == RHI_HSS_SESSION_UNCONNECTED) {
-
-            /* Spec return condition: "0 not passed on initial call" */
-            if (sess_id != 0 || g_rhi_sess.id_in_use)
-                return RHI_SESS_INVALID_SESSION_ID;
-
-            /* Return immediately in progress */
-            g_rhi_sess.session_id  = pal_rhi_alloc_session_id();
-            g_rhi_sess.id_in_use   = true;
-            g_rhi_sess.proto_state = RHI_HSS_CONNECTION_IN_PROGRESS;
-            g_rhi_sess.conn_type = conn_type;
-            g_rhi_send_state.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
-            g_rhi_send_state.io_len = 0;
-            g_rhi_recv_state.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
-            g_rhi_recv_state.io_len = 0;
+        /* Retry calls while IN_PROGRESS for NON-BLOCKING mode */
+        if (conn_type == RHI_CONN_MODE_NON_BLOCKING &&
+            sess->conn_type == RHI_CONN_MODE_NON_BLOCKING &&
+            sess->proto_state == RHI_HSS_CONNECTION_IN_PROGRESS) {
+            sess->proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
 
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = g_rhi_sess.proto_state;
+            rec_enter->gprs[1] = sess->session_id;
+            rec_enter->gprs[2] = sess->proto_state;
 
             return RHI_SESS_SUCCESS;
         }
 
-        /* Retry calls while IN_PROGRESS for NON-BLOCKING mode */
-        if (g_rhi_sess.proto_state == RHI_HSS_CONNECTION_IN_PROGRESS) {
+        /* If state is ESTABLISHED (or anything else), OPEN is invalid by spec */
+        return RHI_SESS_INVALID_STATE_FOR_OPERATION;
+    }
 
-            /* Spec: subsequent calls must pass SessionID returned from first call */
-            if (!g_rhi_sess.id_in_use || sess_id == 0 || sess_id != g_rhi_sess.session_id)
-                return RHI_SESS_INVALID_SESSION_ID;
+    /* Initial call: take a free entry of the session table */
+    for (i = 0; i < RHI_HOST_MAX_SESSIONS; i++)
+    {
+        if (!g_rhi_sess[i].id_in_use) {
+            sess = &g_rhi_sess[i];
+            break;
+        }
+    }
 
-            g_rhi_sess.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
+    if (!sess)
+        return RHI_SESS_PEER_NOT_AVAILABLE;
 
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = g_rhi_sess.proto_state;
+    sess->session_id  = pal_rhi_alloc_session_id();
+    sess->id_in_use   = true;
+    sess->conn_type   = conn_type;
+    sess->rd          = rd;
+    sess->send_state.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
+    sess->send_state.io_len = 0;
+    sess->recv_state.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
+    sess->recv_state.io_len = 0;
 
-            return RHI_SESS_SUCCESS;
-        }
+    /* Blocking open completes immediately, non-blocking on a later call */
+    if (conn_type == RHI_CONN_MODE_BLOCKING)
+        sess->proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
+    else
+        sess->proto_state = RHI_HSS_CONNECTION_IN_PROGRESS;
 
-        /* If state is ESTABLISHED (or anything else), OPEN is invalid by spec */
-        return RHI_SESS_INVALID_STATE_FOR_OPERATION;
-    }
+    rec_enter->gprs[1] = sess->session_id;
+    rec_enter->gprs[2] = sess->proto_state;
 
-    /* Should not reach here */
-    return RHI_SESS_CONNECTION_TYPE_NOT_SUPPORTED;
+    return RHI_SESS_SUCCESS;
 }
 
 /**
@@ -156,80 +215,68 @@ static uint64_t val_host_rhi_session_open(uint64_t sess_id,
  * tracking state, and returns status to the Realm.
  *
  * @param  sess_id       - Session identifier provided by the Realm
- * @param  realm         - Realm structure
+ * @param  rd            - RD of the Realm issuing the call
+ * @param  rec_enter     - REC entry structure of the calling REC
  * @return Returns RHI session status code
  **/
-static uint64_t val_host_rhi_session_close(uint64_t sess_id, val_host_realm_ts *realm)
+static uint64_t val_host_rhi_session_close(uint64_t sess_id,
+                                           uint64_t rd,
+                                           val_host_rec_enter_ts *rec_enter)
 {
-    val_host_rec_enter_ts *rec_enter = NULL;
+    rhi_session_ts *sess;
 
-    rec_enter = &(((val_host_rec_run_ts *)realm->run[0])->enter);
-
-    LOG(ALWAYS, "session_close: id: %lx conn type: %lx\n", sess_id, g_rhi_sess.conn_type);
-    LOG(ALWAYS, "session_close: state: %lx\n", g_rhi_sess.proto_state);
     /* Unknown SessionID parameter */
-    if (!g_rhi_sess.id_in_use || sess_id == 0 || sess_id != g_rhi_sess.session_id)
+    sess = val_host_rhi_session_find(sess_id, rd);
+    if (!sess)
         return RHI_SESS_INVALID_SESSION_ID;
 
+    LOG(ALWAYS, "session_close: id: %lx conn type: %lx\n", sess_id, sess->conn_type);
+    LOG(ALWAYS, "session_close: state: %lx\n", sess->proto_state);
+
     /* INVALID_STATE_FOR_OPERATION: state is UNCONNECTED */
-    if (g_rhi_sess.proto_state == RHI_HSS_SESSION_UNCONNECTED)
+    if (sess->proto_state == RHI_HSS_SESSION_UNCONNECTED)
         return RHI_SESS_INVALID_STATE_FOR_OPERATION;
 
     /* Decide behavior from session's connection mode (stored at OPEN) */
-    if (g_rhi_sess.conn_type == RHI_CONN_MODE_BLOCKING) {
+    if (sess->conn_type == RHI_CONN_MODE_BLOCKING) {
 
         /* BLOCKING close: only meaningful when established */
-        if (g_rhi_sess.proto_state != RHI_HSS_CONNECTION_ESTABLISHED)
+        if (sess->proto_state != RHI_HSS_CONNECTION_ESTABLISHED)
             return RHI_SESS_INVALID_STATE_FOR_OPERATION;
 
         /* Success -> connection_unconnected */
-        g_rhi_sess.proto_state = RHI_HSS_SESSION_UNCONNECTED;
+        rec_enter->gprs[1] = sess->session_id;
+        rec_enter->gprs[2] = RHI_HSS_SESSION_UNCONNECTED;
 
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
-        rec_enter->gprs[2] = g_rhi_sess.proto_state;
-
-        /* Success -> Reset the structure for future use */
-        g_rhi_sess.id_in_use   = false;
-        g_rhi_sess.session_id  = 0;
-        g_rhi_sess.conn_type   = 0;
-        g_rhi_send_state.proto_state = RHI_HSS_SESSION_UNCONNECTED;
-        g_rhi_send_state.io_len = 0;
-        g_rhi_recv_state.proto_state = RHI_HSS_SESSION_UNCONNECTED;
-        g_rhi_recv_state.io_len = 0;
+        /* Success -> Release the entry for future use */
+        val_host_rhi_session_free(sess);
 
         return RHI_SESS_SUCCESS;
     }
 
     /* NON-BLOCKING close */
-    if (g_rhi_sess.conn_type == RHI_CONN_MODE_NON_BLOCKING) {
+    if (sess->conn_type == RHI_CONN_MODE_NON_BLOCKING) {
 
         /* Initial close call from ESTABLISHED: start async close, return immediately */
-        if (g_rhi_sess.proto_state == RHI_HSS_CONNECTION_ESTABLISHED) {
+        if (sess->proto_state == RHI_HSS_CONNECTION_ESTABLISHED) {
 
-            g_rhi_sess.proto_state = RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS;
+            sess->proto_state = RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS;
 
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = g_rhi_sess.proto_state;
+            rec_enter->gprs[1] = sess->session_id;
+            rec_enter->gprs[2] = sess->proto_state;
 
             return RHI_SESS_SUCCESS;
         }
 
         /* Subsequent calls while CLOSE_IN_PROGRESS: poll until done or error */
-        if (g_rhi_sess.proto_state == RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS) {
+        if (sess->proto_state == RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS) {
 
             /* Success -> UNCONNECTED */
-            g_rhi_sess.proto_state = RHI_HSS_SESSION_UNCONNECTED;
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = g_rhi_sess.proto_state;
-
-            /* Success -> Reset the structure for future use */
-            g_rhi_sess.id_in_use   = false;
-            g_rhi_sess.session_id  = 0;
-            g_rhi_sess.conn_type   = 0;
-            g_rhi_send_state.proto_state = RHI_HSS_SESSION_UNCONNECTED;
-            g_rhi_send_state.io_len = 0;
-            g_rhi_recv_state.proto_state = RHI_HSS_SESSION_UNCONNECTED;
-            g_rhi_recv_state.io_len = 0;
+            rec_enter->gprs[1] = sess->session_id;
+            rec_enter->gprs[2] = RHI_HSS_SESSION_UNCONNECTED;
+
+            /* Success -> Release the entry for future use */
+            val_host_rhi_session_free(sess);
 
             return RHI_SESS_SUCCESS;
         }
@@ -245,156 +292,123 @@ static uint64_t val_host_rhi_session_close(uint64_t sess_id, val_host_realm_ts *
 /**
  * @brief Handle RHI session send command from the Realm.
  *
- * Validates session state, copies payload from shared buffer, and updates
- * I/O state for blocking or non-blocking modes.
+ * Validates session state and the payload in place in the shared buffer, and
+ * updates I/O state for blocking or non-blocking modes. A non-blocking send
+ * completes on the next send call of the same session.
  *
  * @param  sess_id       - Session identifier provided by the Realm
  * @param  buffer_ipa    - IPA of the payload buffer
  * @param  length        - Length of the payload to send
  * @param  offset        - Offset into the payload buffer
- * @param  realm         - Realm structure
+ * @param  rd            - RD of the Realm issuing the call
+ * @param  rec_enter     - REC entry structure of the calling REC
  * @return Returns RHI session status code
  **/
 static uint64_t val_host_rhi_session_send(uint64_t sess_id,
                                           uint64_t buffer_ipa,
                                           uint64_t length,
                                           uint64_t offset,
-                                          val_host_realm_ts *realm)
+                                          uint64_t rd,
+                                          val_host_rec_enter_ts *rec_enter)
 {
-    val_host_rec_enter_ts *rec_enter = NULL;
-    uint8_t *local_copy = NULL;
-    uint8_t *expected = NULL;
-    uint64_t idx;
-    uint32_t pattern = 0xabcdabcdU;
-
-    rec_enter = &(((val_host_rec_run_ts *)realm->run[0])->enter);
+    rhi_session_ts *sess;
 
-    if (!g_rhi_sess.id_in_use || sess_id == 0 || sess_id != g_rhi_sess.session_id)
+    sess = val_host_rhi_session_find(sess_id, rd);
+    if (!sess)
         return RHI_SESS_INVALID_SESSION_ID;
 
-    if (g_rhi_sess.proto_state == RHI_HSS_SESSION_UNCONNECTED ||
-        g_rhi_sess.proto_state == RHI_HSS_CONNECTION_IN_PROGRESS ||
-        g_rhi_sess.proto_state == RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS)
+    if (sess->proto_state == RHI_HSS_SESSION_UNCONNECTED ||
+        sess->proto_state == RHI_HSS_CONNECTION_IN_PROGRESS ||
+        sess->proto_state == RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS)
         return RHI_SESS_INVALID_STATE_FOR_OPERATION;
 
     if (buffer_ipa == 0 || !ADDR_IS_ALIGNED(buffer_ipa, PAGE_SIZE))
         return RHI_SESS_ACCESS_FAILED;
 
-    buffer_ipa = (uint64_t)(val_get_shared_region_base() + TEST_USE_OFFSET1);
-
-    if (g_rhi_sess.conn_type == RHI_CONN_MODE_BLOCKING) {
-        if (g_rhi_send_state.proto_state != RHI_HSS_CONNECTION_ESTABLISHED &&
-            g_rhi_send_state.proto_state != RHI_HSS_IO_COMPLETE)
-            return RHI_SESS_INVALID_STATE_FOR_OPERATION;
-
-        local_copy = val_host_mem_alloc(PAGE_SIZE, length);
-        expected = val_host_mem_alloc(PAGE_SIZE, length);
-        if (!local_copy || !expected)
-            return RHI_SESS_ACCESS_FAILED;
-
-        val_memcpy(local_copy, (void *)(buffer_ipa + offset), length);
-        for (idx = 0; idx < length; idx++) {
-            expected[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
-        }
-
-        if (val_memcmp(local_copy, expected, length))
-        {
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = RHI_HSS_CONNECTION_ESTABLISHED;
-            rec_enter->gprs[3] = 0;
-            g_rhi_sess.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
-            return RHI_SESS_PEER_NOT_AVAILABLE;
-        }
-
-        g_rhi_send_state.proto_state = RHI_HSS_IO_COMPLETE;
-        g_rhi_send_state.io_len = length;
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
-        rec_enter->gprs[2] = g_rhi_send_state.proto_state;
-        rec_enter->gprs[3] = length;
+    /* Pending non-blocking send completes on this exit */
+    if (sess->conn_type == RHI_CONN_MODE_NON_BLOCKING &&
+        sess->send_state.proto_state == RHI_HSS_IO_IN_PROGRESS) {
+        sess->send_state.proto_state = RHI_HSS_IO_COMPLETE;
+        rec_enter->gprs[1] = sess->session_id;
+        rec_enter->gprs[2] = sess->send_state.proto_state;
+        rec_enter->gprs[3] = sess->send_state.io_len;
         return RHI_SESS_SUCCESS;
     }
 
-    if (g_rhi_sess.conn_type == RHI_CONN_MODE_NON_BLOCKING) {
-        if (g_rhi_send_state.proto_state == RHI_HSS_IO_IN_PROGRESS) {
-            g_rhi_send_state.proto_state = RHI_HSS_IO_COMPLETE;
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = g_rhi_send_state.proto_state;
-            rec_enter->gprs[3] = g_rhi_send_state.io_len;
-            return RHI_SESS_SUCCESS;
-        }
+    if (offset > RHI_HOST_IO_WINDOW_SIZE || length > (RHI_HOST_IO_WINDOW_SIZE - offset))
+        return RHI_SESS_ACCESS_FAILED;
 
-        if (g_rhi_send_state.proto_state != RHI_HSS_CONNECTION_ESTABLISHED &&
-            g_rhi_send_state.proto_state != RHI_HSS_IO_COMPLETE)
-            return RHI_SESS_INVALID_STATE_FOR_OPERATION;
+    buffer_ipa = (uint64_t)(val_get_shared_region_base() + TEST_USE_OFFSET1);
 
-        local_copy = val_host_mem_alloc(PAGE_SIZE, length);
-        expected = val_host_mem_alloc(PAGE_SIZE, length);
-        if (!local_copy || !expected)
-            return RHI_SESS_ACCESS_FAILED;
+    if (sess->send_state.proto_state != RHI_HSS_CONNECTION_ESTABLISHED &&
+        sess->send_state.proto_state != RHI_HSS_IO_COMPLETE)
+        return RHI_SESS_INVALID_STATE_FOR_OPERATION;
 
-        val_memcpy(local_copy, (void *)(buffer_ipa + offset), length);
-        for (idx = 0; idx < length; idx++) {
-            expected[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
-        }
+    if (!val_host_rhi_payload_valid((uint8_t *)(buffer_ipa + offset), length))
+    {
+        rec_enter->gprs[1] = sess->session_id;
+        rec_enter->gprs[2] = RHI_HSS_CONNECTION_ESTABLISHED;
+        rec_enter->gprs[3] = 0;
+        sess->proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
+        return RHI_SESS_PEER_NOT_AVAILABLE;
+    }
 
-        if (val_memcmp(local_copy, expected, length))
-        {
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = RHI_HSS_CONNECTION_ESTABLISHED;
-            rec_enter->gprs[3] = 0;
-            g_rhi_sess.proto_state = RHI_HSS_CONNECTION_ESTABLISHED;
-            return RHI_SESS_PEER_NOT_AVAILABLE;
-        }
+    sess->send_state.io_len = length;
+    rec_enter->gprs[1] = sess->session_id;
 
-        g_rhi_send_state.proto_state = RHI_HSS_IO_IN_PROGRESS;
-        g_rhi_send_state.io_len = length;
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
-        rec_enter->gprs[2] = g_rhi_send_state.proto_state;
+    if (sess->conn_type == RHI_CONN_MODE_BLOCKING) {
+        sess->send_state.proto_state = RHI_HSS_IO_COMPLETE;
+        rec_enter->gprs[2] = sess->send_state.proto_state;
+        rec_enter->gprs[3] = length;
+    } else {
+        sess->send_state.proto_state = RHI_HSS_IO_IN_PROGRESS;
+        rec_enter->gprs[2] = sess->send_state.proto_state;
         rec_enter->gprs[3] = 0;
-        return RHI_SESS_SUCCESS;
     }
 
-    return RHI_SESS_INVALID_STATE_FOR_OPERATION;
+    return RHI_SESS_SUCCESS;
 }
 
 /**
  * @brief Handle RHI session receive command from the Realm.
  *
  * Validates session state, writes payload into the shared buffer, and updates
- * I/O state for blocking or non-blocking modes.
+ * I/O state for blocking or non-blocking modes. A non-blocking receive
+ * completes on the next receive call of the same session.
  *
  * @param  sess_id       - Session identifier provided by the Realm
  * @param  buffer_ipa    - IPA of the destination buffer
  * @param  buffer_size   - Size of the destination buffer
  * @param  offset        - Offset into the destination buffer
- * @param  realm         - Realm structure
+ * @param  rd            - RD of the Realm issuing the call
+ * @param  rec_enter     - REC entry structure of the calling REC
  * @return Returns RHI session status code
  **/
 static uint64_t val_host_rhi_session_receive(uint64_t sess_id,
                                              uint64_t buffer_ipa,
                                              uint64_t buffer_size,
                                              uint64_t offset,
-                                             val_host_realm_ts *realm)
+                                             uint64_t rd,
+                                             val_host_rec_enter_ts *rec_enter)
 {
-    val_host_rec_enter_ts *rec_enter = NULL;
+    rhi_session_ts *sess;
     uint8_t *dest;
     uint64_t idx;
-    uint32_t pattern = 0xabcdabcdU;
+    uint32_t pattern = RHI_HOST_PAYLOAD_PATTERN;
     uint64_t payload_len = 64;
 
-    rec_enter = &(((val_host_rec_run_ts *)realm->run[0])->enter);
-
-    if (!g_rhi_sess.id_in_use || sess_id == 0 || sess_id != g_rhi_sess.session_id)
+    sess = val_host_rhi_session_find(sess_id, rd);
+    if (!sess)
         return RHI_SESS_INVALID_SESSION_ID;
 
-    if (g_rhi_sess.proto_state == RHI_HSS_SESSION_UNCONNECTED ||
-        g_rhi_sess.proto_state == RHI_HSS_CONNECTION_IN_PROGRESS ||
-        g_rhi_sess.proto_state == RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS)
+    if (sess->proto_state == RHI_HSS_SESSION_UNCONNECTED ||
+        sess->proto_state == RHI_HSS_CONNECTION_IN_PROGRESS ||
+        sess->proto_state == RHI_HSS_CONNECTION_CLOSE_IN_PROGRESS)
         return RHI_SESS_INVALID_STATE_FOR_OPERATION;
 
     if (buffer_ipa == 0 && buffer_size == 0)
     {
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
+        rec_enter->gprs[1] = sess->session_id;
         rec_enter->gprs[2] = RHI_HSS_BUFFER_SIZE_DETERMINED;
         rec_enter->gprs[3] = payload_len;
         return RHI_SESS_SUCCESS;
@@ -407,7 +421,7 @@ static uint64_t val_host_rhi_session_receive(uint64_t sess_id,
 
     if (buffer_size == 0)
     {
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
+        rec_enter->gprs[1] = sess->session_id;
         rec_enter->gprs[2] = RHI_HSS_IO_COMPLETE;
         rec_enter->gprs[3] = 0;
         return RHI_SESS_SUCCESS;
@@ -416,90 +430,195 @@ static uint64_t val_host_rhi_session_receive(uint64_t sess_id,
     if (offset >= buffer_size || payload_len > (buffer_size - offset))
         return RHI_SESS_ACCESS_FAILED;
 
-    if (g_rhi_sess.conn_type == RHI_CONN_MODE_BLOCKING) {
-        if (g_rhi_recv_state.proto_state != RHI_HSS_CONNECTION_ESTABLISHED &&
-            g_rhi_recv_state.proto_state != RHI_HSS_IO_COMPLETE)
-            return RHI_SESS_INVALID_STATE_FOR_OPERATION;
+    /* Pending non-blocking receive completes on this exit */
+    if (sess->conn_type == RHI_CONN_MODE_NON_BLOCKING &&
+        sess->recv_state.proto_state == RHI_HSS_IO_IN_PROGRESS) {
+        sess->recv_state.proto_state = RHI_HSS_IO_COMPLETE;
+        rec_enter->gprs[1] = sess->session_id;
+        rec_enter->gprs[2] = sess->recv_state.proto_state;
+        rec_enter->gprs[3] = sess->recv_state.io_len;
+        return RHI_SESS_SUCCESS;
+    }
 
-        dest = (uint8_t *)(buffer_ipa + offset);
-        for (idx = 0; idx < payload_len; idx++) {
-            dest[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
-        }
+    if (sess->recv_state.proto_state != RHI_HSS_CONNECTION_ESTABLISHED &&
+        sess->recv_state.proto_state != RHI_HSS_IO_COMPLETE)
+        return RHI_SESS_INVALID_STATE_FOR_OPERATION;
 
-        g_rhi_recv_state.proto_state = RHI_HSS_IO_COMPLETE;
-        g_rhi_recv_state.io_len = payload_len;
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
-        rec_enter->gprs[2] = g_rhi_recv_state.proto_state;
+    dest = (uint8_t *)(buffer_ipa + offset);
+    for (idx = 0; idx < payload_len; idx++) {
+        dest[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
+    }
+
+    sess->recv_state.io_len = payload_len;
+    rec_enter->gprs[1] = sess->session_id;
+
+    if (sess->conn_type == RHI_CONN_MODE_BLOCKING) {
+        sess->recv_state.proto_state = RHI_HSS_IO_COMPLETE;
+        rec_enter->gprs[2] = sess->recv_state.proto_state;
         rec_enter->gprs[3] = payload_len;
-        return RHI_SESS_SUCCESS;
+    } else {
+        sess->recv_state.proto_state = RHI_HSS_IO_IN_PROGRESS;
+        rec_enter->gprs[2] = sess->recv_state.proto_state;
+        rec_enter->gprs[3] = 0;
     }
 
-    if (g_rhi_sess.conn_type == RHI_CONN_MODE_NON_BLOCKING) {
-        if (g_rhi_recv_state.proto_state == RHI_HSS_IO_IN_PROGRESS) {
-            g_rhi_recv_state.proto_state = RHI_HSS_IO_COMPLETE;
-            rec_enter->gprs[1] = g_rhi_sess.session_id;
-            rec_enter->gprs[2] = g_rhi_recv_state.proto_state;
-            rec_enter->gprs[3] = g_rhi_recv_state.io_len;
-            return RHI_SESS_SUCCESS;
-        }
+    return RHI_SESS_SUCCESS;
+}
 
-        if (g_rhi_recv_state.proto_state != RHI_HSS_CONNECTION_ESTABLISHED &&
-            g_rhi_recv_state.proto_state != RHI_HSS_IO_COMPLETE)
-            return RHI_SESS_INVALID_STATE_FOR_OPERATION;
+/**
+ * @brief Return the synthetic Firmware Activity Log.
+ *
+ * @return Returns the log buffer of RHI_FAL_LOG_SIZE bytes
+ **/
+static const uint8_t *val_host_rhi_fal_log(void)
+{
+    static uint8_t fal_log[RHI_FAL_LOG_SIZE];
+    static bool fal_init;
+    uint64_t idx;
+    uint32_t pattern = RHI_HOST_PAYLOAD_PATTERN;
 
-        dest = (uint8_t *)(buffer_ipa + offset);
-        for (idx = 0; idx < payload_len; idx++) {
-            dest[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
+    if (!fal_init)
+    {
+        for (idx = 0; idx < RHI_FAL_LOG_SIZE; idx++)
+        {
+            fal_log[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
         }
+        fal_init = true;
+    }
 
-        g_rhi_recv_state.proto_state = RHI_HSS_IO_IN_PROGRESS;
-        g_rhi_recv_state.io_len = payload_len;
-        rec_enter->gprs[1] = g_rhi_sess.session_id;
-        rec_enter->gprs[2] = g_rhi_recv_state.proto_state;
-        rec_enter->gprs[3] = 0;
-        return RHI_SESS_SUCCESS;
+    return fal_log;
+}
+
+/**
+ * @brief Map a FAL streaming window into a Realm.
+ *
+ * The window is mapped once as NS shared memory. Subsequent RHI_FAL_READ calls
+ * from the Realm that pass the window IPA fill its ring with as much of the log
+ * as fits, instead of copying one buffer per host call.
+ *
+ * @param  realm         - Realm structure
+ * @param  size          - Size of the window, a multiple of PAGE_SIZE
+ * @return Returns index of the window in realm->granules, 0 on failure
+ **/
+uint32_t val_host_rhi_fal_stream_init(val_host_realm_ts *realm, uint64_t size)
+{
+    uint32_t index;
+
+    if (!realm || size <= RHI_FAL_WINDOW_DATA_OFFSET || !ADDR_IS_ALIGNED(size, PAGE_SIZE))
+        return 0;
+
+    index = val_host_map_ns_shared_region(realm, size, ATTR_NORMAL_WB | ATTR_STAGE2_MASK);
+    if (!index)
+    {
+        LOG(ERROR, "FAL window mapping failed\n");
+        return 0;
     }
 
-    return RHI_SESS_INVALID_STATE_FOR_OPERATION;
+    g_fal_stream.rd = realm->rd;
+    g_fal_stream.ipa = realm->granules[index].ipa;
+    g_fal_stream.win = (val_rhi_fal_window_ts *)realm->granules[index].pa;
+    g_fal_stream.data_size = size - RHI_FAL_WINDOW_DATA_OFFSET;
+    g_fal_stream.prod = 0;
+
+    val_memset(g_fal_stream.win, 0, RHI_FAL_WINDOW_DATA_OFFSET);
+    g_fal_stream.win->data_size = g_fal_stream.data_size;
+    g_fal_stream.win->log_size = RHI_FAL_LOG_SIZE;
+    g_fal_offset = 0;
+
+    return index;
+}
+
+/**
+ * @brief Forget the RHI state of a Realm that is being destroyed, so that a
+ *        later Realm created at the same RD never reaches a stale window or
+ *        inherits the sessions it left open.
+ *
+ * @param  rd            - RD of the Realm
+ * @return void
+ **/
+void val_host_rhi_realm_release(uint64_t rd)
+{
+    uint32_t i;
+
+    for (i = 0; i < RHI_HOST_MAX_SESSIONS; i++)
+    {
+        if (g_rhi_sess[i].id_in_use && g_rhi_sess[i].rd == rd)
+            val_host_rhi_session_free(&g_rhi_sess[i]);
+    }
+
+    if (g_fal_stream.rd == rd)
+        val_memset(&g_fal_stream, 0, sizeof(g_fal_stream));
+}
+
+/**
+ * @brief Fill the free part of the FAL streaming window ring.
+ *
+ * @param  rec_enter     - REC entry structure of the calling REC
+ * @return Returns RHI FAL status code
+ **/
+static uint64_t val_host_rhi_fal_stream_fill(val_host_rec_enter_ts *rec_enter)
+{
+    val_rhi_fal_window_ts *win = g_fal_stream.win;
+    uint8_t *ring = (uint8_t *)win + RHI_FAL_WINDOW_DATA_OFFSET;
+    const uint8_t *fal_log = val_host_rhi_fal_log();
+    uint64_t data_size = g_fal_stream.data_size;
+    uint64_t prod = g_fal_stream.prod;
+    /* The Realm is done reading the ring below cons */
+    uint64_t cons = __atomic_load_n(&win->cons, __ATOMIC_ACQUIRE);
+    uint64_t produced = 0, pos, chunk, space;
+
+    if ((prod - cons) > data_size)
+        return RHI_FAL_ACCESS_FAILED;
+
+    space = MIN(data_size - (prod - cons), RHI_FAL_LOG_SIZE - g_fal_offset);
+
+    /* At most two copies, the second one after the ring wraps */
+    while (produced < space)
+    {
+        pos = prod % data_size;
+        chunk = MIN(space - produced, data_size - pos);
+        val_memcpy(ring + pos, fal_log + g_fal_offset, chunk);
+        g_fal_offset += chunk;
+        prod += chunk;
+        produced += chunk;
+    }
+
+    /* Publish the data before the producer index */
+    g_fal_stream.prod = prod;
+    __atomic_store_n(&win->prod, prod, __ATOMIC_RELEASE);
+
+    rec_enter->gprs[1] = produced;
+    rec_enter->gprs[2] = RHI_FAL_LOG_SIZE - g_fal_offset;
+    return RHI_FAL_SUCCESS;
 }
 
 /**
  * @brief Handle RHI FAL read command from the Realm.
  *
- * Populates a synthetic log buffer and returns chunks of data to the Realm.
+ * Returns chunks of a synthetic log to the Realm. When the buffer is the FAL
+ * streaming window of the calling Realm, the window ring is filled instead.
  *
  * @param  buffer_ipa    - IPA of the output buffer
  * @param  buffer_size   - Size of the output buffer
- * @param  realm         - Realm structure
+ * @param  rd            - RD of the Realm issuing the call
+ * @param  rec_enter     - REC entry structure of the calling REC
  * @return Returns RHI FAL status code
  **/
 static uint64_t val_host_rhi_fal_read(uint64_t buffer_ipa,
                                       uint64_t buffer_size,
-                                      val_host_realm_ts *realm)
+                                      uint64_t rd,
+                                      val_host_rec_enter_ts *rec_enter)
 {
-    val_host_rec_enter_ts *rec_enter = NULL;
-    static uint8_t fal_log[RHI_FAL_LOG_SIZE];
-    static bool fal_init;
     uint64_t remaining;
     uint64_t copy_len;
-    uint64_t idx;
-    uint32_t pattern = 0xabcdabcdU;
-
-    rec_enter = &(((val_host_rec_run_ts *)realm->run[0])->enter);
 
     if (buffer_ipa == 0 || !ADDR_IS_ALIGNED(buffer_ipa, PAGE_SIZE))
         return RHI_FAL_ACCESS_FAILED;
 
-    buffer_ipa = (uint64_t)(val_get_shared_region_base() + TEST_USE_OFFSET1);
+    if (g_fal_stream.win && g_fal_stream.rd == rd && g_fal_stream.ipa == buffer_ipa)
+        return val_host_rhi_fal_stream_fill(rec_enter);
 
-    if (!fal_init)
-    {
-        for (idx = 0; idx < RHI_FAL_LOG_SIZE; idx++)
-        {
-            fal_log[idx] = ((uint8_t *)&pattern)[idx % sizeof(pattern)];
-        }
-        fal_init = true;
-    }
+    buffer_ipa = (uint64_t)(val_get_shared_region_base() + TEST_USE_OFFSET1);
 
     if (g_fal_offset >= RHI_FAL_LOG_SIZE || buffer_size == 0)
     {
@@ -510,7 +629,7 @@ static uint64_t val_host_rhi_fal_read(uint64_t buffer_ipa,
 
     remaining = RHI_FAL_LOG_SIZE - g_fal_offset;
     copy_len = MIN(buffer_size, remaining);
-    val_memcpy((void *)buffer_ipa, fal_log + g_fal_offset, copy_len);
+    val_memcpy((void *)buffer_ipa, val_host_rhi_fal_log() + g_fal_offset, copy_len);
     g_fal_offset += copy_len;
     remaining = RHI_FAL_LOG_SIZE - g_fal_offset;
 
@@ -988,16 +1107,32 @@ uint64_t val_host_rhi_da_dispatch(val_host_realm_ts *realm,
  * @return Returns status code indicating success or failure of the dispatch
 **/
 uint64_t val_host_rhi_dispatch(val_host_realm_ts *realm)
+{
+    return val_host_rhi_dispatch_rec(realm, 0);
+}
+
+/**
+ * @brief Dispatch an RHI host call exit taken on a given REC.
+ *
+ * Reads the RHI function identifier from the REC exit of REC[rec_idx] and
+ * writes the results to the REC entry of the same REC, so RECs of a Realm
+ * can drive independent sessions.
+ *
+ * @param  realm         - Realm structure
+ * @param  rec_idx       - Index of the REC which took the host call exit
+ * @return Returns status code indicating success or failure of the dispatch
+**/
+uint64_t val_host_rhi_dispatch_rec(val_host_realm_ts *realm, uint64_t rec_idx)
 {
     val_host_rec_enter_ts *rec_enter = NULL;
     val_host_rec_exit_ts *rec_exit = NULL;
     uint64_t fid;
 
-    if (!realm)
+    if (!realm || rec_idx >= VAL_MAX_REC_COUNT || !realm->run[rec_idx])
         return VAL_ERROR;
 
-    rec_enter = &(((val_host_rec_run_ts *)realm->run[0])->enter);
-    rec_exit = &(((val_host_rec_run_ts *)realm->run[0])->exit);
+    rec_enter = &(((val_host_rec_run_ts *)realm->run[rec_idx])->enter);
+    rec_exit = &(((val_host_rec_run_ts *)realm->run[rec_idx])->exit);
 
     fid = rec_exit->gprs[0];
 
@@ -1011,24 +1146,25 @@ uint64_t val_host_rhi_dispatch(val_host_realm_ts *realm)
         rec_enter->gprs[1] = RHI_CONN_MODE_SUPPORTED_MASK;
         return VAL_SUCCESS;
     case RHI_SESSION_OPEN:
-        rec_enter->gprs[0] = val_host_rhi_session_open(rec_exit->gprs[1], rec_exit->gprs[2], realm);
+        rec_enter->gprs[0] = val_host_rhi_session_open(rec_exit->gprs[1], rec_exit->gprs[2],
+                                                       realm->rd, rec_enter);
         return VAL_SUCCESS;
     case RHI_SESSION_CLOSE:
-        rec_enter->gprs[0] = val_host_rhi_session_close(rec_exit->gprs[1], realm);
+        rec_enter->gprs[0] = val_host_rhi_session_close(rec_exit->gprs[1], realm->rd, rec_enter);
         return VAL_SUCCESS;
     case RHI_SESSION_SEND:
         rec_enter->gprs[0] = val_host_rhi_session_send(rec_exit->gprs[1],
                                                        rec_exit->gprs[2],
                                                        rec_exit->gprs[3],
                                                        rec_exit->gprs[4],
-                                                       realm);
+                                                       realm->rd, rec_enter);
         return VAL_SUCCESS;
     case RHI_SESSION_RECEIVE:
         rec_enter->gprs[0] = val_host_rhi_session_receive(rec_exit->gprs[1],
                                                           rec_exit->gprs[2],
                                                           rec_exit->gprs[3],
                                                           rec_exit->gprs[4],
-                                                          realm);
+                                                          realm->rd, rec_enter);
         return VAL_SUCCESS;
 
     /* Firmware Activity Log */
@@ -1044,7 +1180,7 @@ uint64_t val_host_rhi_dispatch(val_host_realm_ts *realm)
     case RHI_FAL_READ:
         rec_enter->gprs[0] = val_host_rhi_fal_read(rec_exit->gprs[1],
                                                    rec_exit->gprs[2],
-                                                   realm);
+                                                   realm->rd, rec_enter);
         return VAL_SUCCESS;
 
 
@@ -17,45 +17,46 @@
 
 uint32_t g_da_vdev_count;
 
-uint64_t da_init(val_host_realm_ts *realm,
-                  val_host_pdev_ts *pdev_obj,
-                  val_host_vdev_ts *vdev_obj,
-                  uint8_t vdev_state)
+/**
+ * @brief  Allocates memory owned by the PDEV object. With DA_PDEV_REUSE it is
+ *         carved from the persistent heap, so that it outlives the test with the
+ *         shared PDEV; scratch memory of the PDEV setup is not.
+ * @param  alignment - alignment for the address. It must be in power of 2.
+ * @param  size      - Size of the region. It must not be zero.
+ * @return Returns the allocated memory, NULL on failure
+ **/
+static void *da_pdev_alloc(size_t alignment, size_t size)
 {
-    uint64_t feature_reg, pdev, ret, req_addr, resp_addr, vdev;
+    void *addr;
+
+#ifdef DA_PDEV_REUSE
+    val_host_mem_alloc_persist(true);
+#endif
+    addr = val_host_mem_alloc(alignment, size);
+#ifdef DA_PDEV_REUSE
+    val_host_mem_alloc_persist(false);
+#endif
+
+    return addr;
+}
+
+/* Create the PDEV and drive it through the SPDM handshake to RMI_PDEV_READY */
+static uint64_t da_init_pdev(val_host_pdev_ts *pdev_obj)
+{
+    uint64_t pdev, ret, req_addr, resp_addr;
     val_host_pdev_params_ts *pdev_params;
-    val_host_vdev_params_ts *vdev_params;
     val_smc_param_ts args;
-    uint64_t i, j, flags_pdev, flags_vdev;
+    uint64_t i, j;
     uint32_t num_bdf;
-    val_host_vdev_flags_ts vdev_flags;
     int rc;
     uint8_t public_key_algo;
-    uint8_t *shared_vca_buff = (val_get_shared_region_base() + TEST_USE_OFFSET1);
-    uint8_t *shared_cert_buff = (val_get_shared_region_base() + TEST_USE_OFFSET2);
-    uint8_t *shared_pubkey_buff = (val_get_shared_region_base() + TEST_USE_OFFSET3);
-    uint64_t vca_size = 0;
-    uint64_t cert_size = 0;
-    uint64_t pubkey_size = 0;
-    val_host_realm_flags_ts realm_flags;
     val_host_public_key_params_ts *pubkey_params;
     val_host_pdev_flags_ts pdev_flags;
     uint64_t aux_count;
     uint32_t rp_bdf, status;
 
-    val_memset(pdev_obj, 0, sizeof(*pdev_obj));
-    val_memset(vdev_obj, 0, sizeof(*vdev_obj));
-    g_da_vdev_count = 1;
-
-    /* Read Feature Register 0 and check for DA support */
-    val_host_rmi_features(0, &feature_reg);
-    if (VAL_EXTRACT_BITS(feature_reg, 42, 42) == 0) {
-        LOG(ERROR, "DA feature not supported.\n");
-        return VAL_ERROR;
-    }
-
     /* Allocate and delegate PDEV */
-    pdev = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    pdev = (uint64_t)da_pdev_alloc(PAGE_SIZE, PAGE_SIZE);
     if (!pdev)
     {
         LOG(ERROR, "Failed to allocate memory for pdev");
@@ -70,14 +71,13 @@ uint64_t da_init(val_host_realm_ts *realm,
     }
 
     /* Allocate memory for params */
-    pdev_params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    pdev_params = val_host_mem_alloc_zeroed(PAGE_SIZE, PAGE_SIZE);
 
     if (pdev_params == NULL)
     {
         LOG(ERROR, "Failed to allocate memory for pdev_params");
         return VAL_ERROR;
     }
-    val_memset(pdev_params, 0, PAGE_SIZE_4K);
 
     num_bdf = val_pcie_get_num_bdf();
     if (num_bdf == VAL_ERROR)
@@ -131,7 +131,7 @@ uint64_t da_init(val_host_realm_ts *realm,
 
     for (j = 0; j < pdev_params->num_aux; j++)
     {
-        pdev_params->aux[j] = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+        pdev_params->aux[j] = (uint64_t)da_pdev_alloc(PAGE_SIZE, PAGE_SIZE);
         if (!pdev_params->aux[j])
         {
             LOG(ERROR, "Failed to allocate memory for aux pdev");
@@ -147,7 +147,9 @@ uint64_t da_init(val_host_realm_ts *realm,
                 return VAL_ERROR;
             }
         }
+        pdev_obj->pdev_aux[j] = (void *)pdev_params->aux[j];
     }
+    pdev_obj->pdev_aux_num = (uint32_t)pdev_params->num_aux;
 
     pdev_params->ncoh_num_addr_range = pdev_obj->ncoh_num_addr_range;
 
@@ -179,7 +181,7 @@ uint64_t da_init(val_host_realm_ts *realm,
     LOG(TEST, "\n\tPDEV Create is successful and PDEV state is PDEV_NEW\n");
 
     /* Allocate buffer to cache VCA */
-    pdev_obj->vca = val_host_mem_alloc(PAGE_SIZE, VAL_HOST_PDEV_VCA_LEN_MAX);
+    pdev_obj->vca = da_pdev_alloc(PAGE_SIZE, VAL_HOST_PDEV_VCA_LEN_MAX);
     pdev_obj->vca_len = 0;
     if (pdev_obj->vca == NULL) {
         return VAL_ERROR;
@@ -187,21 +189,21 @@ uint64_t da_init(val_host_realm_ts *realm,
 
     /* Allocate buffer to cache device certificate */
     pdev_obj->cert_slot_id = 0;
-    pdev_obj->cert_chain = val_host_mem_alloc(PAGE_SIZE, VAL_HOST_PDEV_CERT_LEN_MAX);
+    pdev_obj->cert_chain = da_pdev_alloc(PAGE_SIZE, VAL_HOST_PDEV_CERT_LEN_MAX);
     pdev_obj->cert_chain_len = 0;
     if (pdev_obj->cert_chain == NULL) {
         return VAL_ERROR;
     }
 
     /* Allocate buffer to store extracted public key */
-    pdev_obj->public_key = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    pdev_obj->public_key = da_pdev_alloc(PAGE_SIZE, PAGE_SIZE);
     if (pdev_obj->public_key == NULL) {
         return VAL_ERROR;
     }
     pdev_obj->public_key_len = PAGE_SIZE;
 
     /* Allocate buffer to store public key metadata */
-    pdev_obj->public_key_metadata = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    pdev_obj->public_key_metadata = da_pdev_alloc(PAGE_SIZE, PAGE_SIZE);
     if (pdev_obj->public_key_metadata == NULL) {
         return VAL_ERROR;
     }
@@ -209,7 +211,7 @@ uint64_t da_init(val_host_realm_ts *realm,
 
 
     /* Allocate memory for req addr buffer */
-    req_addr = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    req_addr = (uint64_t)da_pdev_alloc(PAGE_SIZE, PAGE_SIZE);
     if (!req_addr)
     {
         LOG(ERROR, "Failed to allocate memory for req_addr");
@@ -217,7 +219,7 @@ uint64_t da_init(val_host_realm_ts *realm,
     }
 
     /* Allocate memory for resp_addr buffer */
-    resp_addr = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    resp_addr = (uint64_t)da_pdev_alloc(PAGE_SIZE, PAGE_SIZE);
     if (!resp_addr)
     {
         LOG(ERROR, "Failed to allocate memory for resp_addr");
@@ -225,7 +227,9 @@ uint64_t da_init(val_host_realm_ts *realm,
     }
 
     pdev_obj->pdev = pdev;
-    pdev_obj->dev_comm_data = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    pdev_obj->dev_comm_data = da_pdev_alloc(PAGE_SIZE, PAGE_SIZE);
+    if (pdev_obj->dev_comm_data == NULL)
+        return VAL_ERROR;
     pdev_obj->dev_comm_data->enter.req_addr = req_addr;
     pdev_obj->dev_comm_data->enter.resp_addr = resp_addr;
 
@@ -258,14 +262,13 @@ uint64_t da_init(val_host_realm_ts *realm,
         pdev_obj->public_key_sig_algo = RMI_SIG_RSASSA_3072;
     }
 
-    pubkey_params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    pubkey_params = val_host_mem_alloc_zeroed(PAGE_SIZE, PAGE_SIZE);
     if (!pubkey_params)
     {
         LOG(ERROR, "\tFailed to allocate memory for pub_key\n");
         return VAL_ERROR;
     }
 
-    val_memset(pubkey_params, 0, PAGE_SIZE_4K);
     val_memcpy(pubkey_params->key, pdev_obj->public_key, pdev_obj->public_key_len);
     val_memcpy(pubkey_params->metadata, pdev_obj->public_key_metadata,
                                 pdev_obj->public_key_metadata_len);
@@ -304,6 +307,147 @@ uint64_t da_init(val_host_realm_ts *realm,
 
     LOG(TEST, "\n\tPDEV state has been changed to RMI_PDEV_READY\n");
 
+    return VAL_SUCCESS;
+}
+
+#ifdef DA_PDEV_REUSE
+/* PDEV kept in RMI_PDEV_READY by da_init() across the tests of a suite */
+static val_host_pdev_ts g_da_shared_pdev;
+static bool g_da_shared_pdev_valid;
+
+/**
+ * @brief  Releases the shared PDEV: tears it down and undelegates its granules.
+ *         If the teardown fails the PDEV is not reused, but its granules and
+ *         memory stay out of the heap since the RMM may still own them.
+ * @param  void
+ * @return void
+ **/
+void da_release_shared_pdev(void)
+{
+    uint32_t i;
+
+    if (!g_da_shared_pdev_valid)
+        return;
+
+    g_da_shared_pdev_valid = false;
+
+    if (val_host_pdev_teardown(&g_da_shared_pdev, g_da_shared_pdev.pdev))
+    {
+        LOG(ERROR, "Shared PDEV teardown failed, its memory is not reused\n");
+        return;
+    }
+
+    (void)val_host_rmi_granule_undelegate(g_da_shared_pdev.pdev);
+    for (i = 0; i < g_da_shared_pdev.pdev_aux_num; i++)
+        (void)val_host_rmi_granule_undelegate((uint64_t)g_da_shared_pdev.pdev_aux[i]);
+
+    val_host_mem_alloc_persist_release();
+}
+
+/**
+ * @brief  Checks whether a PDEV is the one shared across tests.
+ * @param  pdev - PA of the PDEV granule
+ * @return true if the PDEV is shared, false otherwise
+ **/
+bool da_pdev_is_shared(uint64_t pdev)
+{
+    return g_da_shared_pdev_valid && (pdev == g_da_shared_pdev.pdev);
+}
+#else
+bool da_pdev_is_shared(uint64_t pdev)
+{
+    (void)pdev;
+    return false;
+}
+#endif
+
+#ifdef DA_PDEV_REUSE
+
+static bool da_get_shared_pdev(val_host_pdev_ts *pdev_obj)
+{
+    val_smc_param_ts args;
+
+    if (!g_da_shared_pdev_valid)
+        return false;
+
+    args = val_host_rmi_pdev_get_state(g_da_shared_pdev.pdev);
+    if (args.x0 || (args.x1 != RMI_PDEV_READY))
+    {
+        LOG(DBG, "Shared PDEV is not ready, recreating it\n");
+        da_release_shared_pdev();
+        return false;
+    }
+
+    *pdev_obj = g_da_shared_pdev;
+    LOG(TEST, "\n\tReusing PDEV in RMI_PDEV_READY state\n");
+    return true;
+}
+
+static void da_share_pdev(val_host_pdev_ts *pdev_obj)
+{
+    uint32_t i;
+
+    /* Keep the PDEV granules out of the per test postamble undelegation */
+    val_host_mem_free(val_host_remove_granule(&mem_track[0].gran_type.ns, pdev_obj->pdev));
+    for (i = 0; i < pdev_obj->pdev_aux_num; i++)
+        val_host_mem_free(val_host_remove_granule(&mem_track[0].gran_type.ns,
+                                                  (uint64_t)pdev_obj->pdev_aux[i]));
+
+    g_da_shared_pdev = *pdev_obj;
+    g_da_shared_pdev_valid = true;
+}
+#endif
+
+uint64_t da_init(val_host_realm_ts *realm,
+                  val_host_pdev_ts *pdev_obj,
+                  val_host_vdev_ts *vdev_obj,
+                  uint8_t vdev_state)
+{
+    uint64_t feature_reg, ret, req_addr, resp_addr, vdev;
+    val_host_vdev_params_ts *vdev_params;
+    val_smc_param_ts args;
+    uint64_t j, flags_pdev, flags_vdev;
+    val_host_vdev_flags_ts vdev_flags;
+    uint8_t *shared_vca_buff = (val_get_shared_region_base() + TEST_USE_OFFSET1);
+    uint8_t *shared_cert_buff = (val_get_shared_region_base() + TEST_USE_OFFSET2);
+    uint8_t *shared_pubkey_buff = (val_get_shared_region_base() + TEST_USE_OFFSET3);
+    uint64_t vca_size = 0;
+    uint64_t cert_size = 0;
+    uint64_t pubkey_size = 0;
+    val_host_realm_flags_ts realm_flags;
+
+    val_memset(pdev_obj, 0, sizeof(*pdev_obj));
+    val_memset(vdev_obj, 0, sizeof(*vdev_obj));
+    g_da_vdev_count = 1;
+
+    /* Read Feature Register 0 and check for DA support */
+    val_host_rmi_features(0, &feature_reg);
+    if (VAL_EXTRACT_BITS(feature_reg, 42, 42) == 0) {
+        LOG(ERROR, "DA feature not supported.\n");
+        return VAL_ERROR;
+    }
+
+#ifdef DA_PDEV_REUSE
+    if (!da_get_shared_pdev(pdev_obj))
+#endif
+    {
+        /* Only the PDEV objects and cached cert chain/VCA go to the persistent heap */
+        ret = da_init_pdev(pdev_obj);
+#ifdef DA_PDEV_REUSE
+        if (ret)
+            val_host_mem_alloc_persist_release();
+#endif
+        if (ret)
+            return ret;
+
+#ifdef DA_PDEV_REUSE
+        da_share_pdev(pdev_obj);
+#endif
+    }
+
+    req_addr = pdev_obj->dev_comm_data->enter.req_addr;
+    resp_addr = pdev_obj->dev_comm_data->enter.resp_addr;
+
     vca_size = pdev_obj->vca_len;
     val_memcpy(shared_vca_buff, pdev_obj->vca, vca_size);
 
@@ -345,15 +489,13 @@ uint64_t da_init(val_host_realm_ts *realm,
     }
 
     /* Allocate memory for vdev params */
-    vdev_params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    vdev_params = val_host_mem_alloc_zeroed(PAGE_SIZE, PAGE_SIZE);
     if (vdev_params == NULL)
     {
         LOG(ERROR, "Failed to allocate memory for vdev_params");
         return VAL_ERROR;
     }
 
-    val_memset(vdev_params, 0, PAGE_SIZE_4K);
-
     /* Populate params */
     val_memset(&vdev_flags, 0, sizeof(vdev_flags));
     vdev_params->flags = 0;
@@ -415,7 +557,7 @@ uint64_t da_init(val_host_realm_ts *realm,
 
     LOG(TEST, "\n\tVDEV Create is successful and VDEV state is VDEV_NEW\n");
 
-    vdev_obj->pdev = pdev;
+    vdev_obj->pdev = pdev_obj->pdev;
     vdev_obj->vdev = vdev;
     vdev_obj->dev_comm_data = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
     vdev_obj->dev_comm_data->enter.req_addr = req_addr;
@@ -498,12 +640,10 @@ uint64_t da_create_vdev(val_host_realm_ts *realm, val_host_pdev_ts *pdev_obj,
     if (ret)
         return VAL_ERROR;
 
-    vdev_params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    vdev_params = val_host_mem_alloc_zeroed(PAGE_SIZE, PAGE_SIZE);
     if (vdev_params == NULL)
         return VAL_ERROR;
 
-    val_memset(vdev_params, 0, PAGE_SIZE_4K);
-
     val_memset(&vdev_flags, 0, sizeof(vdev_flags));
 
     vdev_params->flags = 0;
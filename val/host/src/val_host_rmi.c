@@ -8,6 +8,7 @@
 #include "val_host_rmi.h"
 #include "val_libc.h"
 #include "val_host_realm.h"
+#include "val_host_measurement.h"
 
 /**
  *   @brief    Returns RMI version
@@ -80,6 +81,7 @@ uint64_t val_host_rmi_data_create(uint64_t rd, uint64_t data,
         return ret;
     }
     val_host_update_granule_state(rd, GRANULE_DATA, data, ipa, 0, 0);
+    val_host_meas_data_create(rd, ipa, (const void *)src, flags);
     return ret;
 
 }
@@ -122,6 +124,7 @@ uint64_t val_host_rmi_granule_delegate(uint64_t addr)
     }
 
     val_host_add_granule(GRANULE_DELEGATED, addr, NULL);
+    val_host_mem_zero_pool_delegate(addr, true);
 
     return ret;
 }
@@ -141,6 +144,7 @@ uint64_t val_host_rmi_granule_undelegate(uint64_t addr)
         return ret;
     }
     val_host_update_destroy_granule_state(0, addr, 0, 0, GRANULE_UNDELEGATED, 0, 0);
+    val_host_mem_zero_pool_delegate(addr, false);
     return ret;
 }
 
@@ -185,6 +189,7 @@ uint64_t val_host_rmi_realm_create(uint64_t rd, uint64_t params_ptr)
         return ret;
     }
     val_host_update_granule_state(rd, GRANULE_RD, rd, 0, 0, 0);
+    val_host_meas_realm_create(rd, (const val_host_realm_params_ts *)params_ptr);
     return ret;
 }
 
@@ -202,6 +207,7 @@ uint64_t val_host_rmi_realm_destroy(uint64_t rd)
     {
         return ret;
     }
+    val_host_meas_realm_destroy(rd);
     val_host_update_destroy_granule_state(rd, rd, 0, 0, GRANULE_DELEGATED, GRANULE_RD, 0);
     return ret;
 }
@@ -248,6 +254,7 @@ uint64_t val_host_rmi_rec_create(uint64_t rd, uint64_t rec,
         return ret;
     }
     val_host_update_granule_state(rd, GRANULE_REC, rec, 0, 0, 0);
+    val_host_meas_rec_create(rd, (const val_host_rec_params_ts *)params_ptr);
     return ret;
 }
 
@@ -476,6 +483,8 @@ uint64_t val_host_rmi_rtt_init_ripas(uint64_t rd, uint64_t base,
     args = val_smc_call(RMI_RTT_INIT_RIPAS, rd, base, top, 0, 0, 0, 0, 0, 0, 0);
 
     *out_top = args.x1;
+    if (!args.x0)
+        val_host_meas_init_ripas(rd, base, args.x1);
     return args.x0;
 }
 
@@ -36,5 +36,7 @@ int val_realm_pgt_create(val_memory_region_descriptor_ts *mem_desc);
 void val_realm_update_xlat_ctx_ias_oas(uint64_t ias, uint64_t oas);
 void val_realm_read_attributes(uint64_t va, uint32_t *attr);
 int val_realm_update_attributes(uint64_t size, uint64_t va, uint32_t attr);
+void *val_buffer_alloc_calloc(size_t n, size_t size);
+void val_buffer_alloc_free(void *ptr);
 
 #endif /* _VAL_REALM_MEMORY_H_ */
@@ -133,6 +133,8 @@ uint64_t val_realm_rsi_host_call(uint16_t imm);
 val_realm_rsi_host_call_t *val_realm_rsi_host_call_ripas(uint16_t imm);
 uint64_t val_realm_rsi_host_call_struct(uint64_t gv_realm_host_call1);
 uint64_t val_realm_rsi_rhi_host(val_realm_rsi_host_call_t *rsi_host_call);
+uint64_t val_realm_rhi_fal_stream_read(uint64_t window_ipa, uint8_t *dst,
+                                        uint64_t dst_size, uint64_t *len);
 uint64_t val_realm_get_ipa_width(void);
 val_smc_param_ts val_realm_rsi_ipa_state_set(uint64_t base, uint64_t size, uint8_t ripas,
                                                                          uint64_t flags);
@@ -140,6 +142,8 @@ val_smc_param_ts val_realm_rsi_ipa_state_get(uint64_t base, uint64_t top);
 uint64_t val_realm_rsi_host_params(val_realm_rsi_host_call_t *realm_host_params);
 val_smc_param_ts val_realm_rsi_attestation_token_continue(uint64_t addr, uint64_t offset,
                                                            uint64_t size, uint64_t *len);
+uint64_t val_realm_rsi_attestation_token_fetch(uint8_t *buf, uint64_t buf_size,
+                                                uint64_t *token_size);
 val_smc_param_ts val_realm_rsi_attestation_token_init(uint64_t challenge_0,
                  uint64_t challenge_1, uint64_t challenge_2, uint64_t challenge_3,
                  uint64_t challenge_4, uint64_t challenge_5, uint64_t challenge_6,
@@ -6,6 +6,7 @@
  */
 #include "val_realm_memory.h"
 #include "val_realm_rsi.h"
+#include "val_libc.h"
 
 REGISTER_XLAT_CONTEXT2(acs_realm,
 		       REALM_MEM_REGIONS,
@@ -48,6 +49,18 @@ extern uintptr_t __BSS_START__, __BSS_END__;
                                 (BSS_END - BSS_START),          \
                                 MT_RW_DATA | MT_REALM)
 
+/* Heap backing mbedtls allocations made by the Realm */
+#define REALM_CRYPTO_HEAP_SIZE   0x10000UL
+
+typedef struct {
+    /* Size of the block including this header */
+    uint64_t size;
+    uint64_t free;
+} realm_heap_blk_ts;
+
+static __attribute__((aligned(16))) uint8_t realm_crypto_heap[REALM_CRYPTO_HEAP_SIZE];
+static bool realm_crypto_heap_init;
+
 
 /**
  *   @brief    Add regions assigned to realm into its translation table data structure.
@@ -133,4 +146,81 @@ void val_realm_read_attributes(uint64_t va, uint32_t *attr)
 int val_realm_update_attributes(uint64_t size, uint64_t va, uint32_t attr)
 {
     return xlat_change_mem_attributes_ctx(&acs_realm_xlat_ctx, va, size, attr);
-}
\ No newline at end of file
+}
+
+/**
+ *   @brief    Allocates zeroed memory for mbedtls from the Realm crypto heap.
+ *             Blocks are carved first fit and merged with free neighbours on release.
+ *   @param    n     - Number of elements
+ *   @param    size  - Size of each element
+ *   @return   Returns allocated memory, NULL on failure
+**/
+void *val_buffer_alloc_calloc(size_t n, size_t size)
+{
+    realm_heap_blk_ts *blk, *next;
+    uint8_t *end = realm_crypto_heap + REALM_CRYPTO_HEAP_SIZE;
+    uint64_t need;
+
+    if (!realm_crypto_heap_init)
+    {
+        blk = (realm_heap_blk_ts *)realm_crypto_heap;
+        blk->size = REALM_CRYPTO_HEAP_SIZE;
+        blk->free = 1;
+        realm_crypto_heap_init = true;
+    }
+
+    if (n && size > (REALM_CRYPTO_HEAP_SIZE / n))
+        return NULL;
+
+    need = ((n * size + 15UL) & ~15UL) + sizeof(realm_heap_blk_ts);
+
+    for (blk = (realm_heap_blk_ts *)realm_crypto_heap; (uint8_t *)blk < end;
+         blk = (realm_heap_blk_ts *)((uint8_t *)blk + blk->size))
+    {
+        if (!blk->free || blk->size < need)
+            continue;
+
+        /* Split off the remainder when it can hold another block */
+        if (blk->size - need > sizeof(realm_heap_blk_ts))
+        {
+            next = (realm_heap_blk_ts *)((uint8_t *)blk + need);
+            next->size = blk->size - need;
+            next->free = 1;
+            blk->size = need;
+        }
+
+        blk->free = 0;
+        val_memset(blk + 1, 0, blk->size - sizeof(realm_heap_blk_ts));
+        return blk + 1;
+    }
+
+    return NULL;
+}
+
+/**
+ *   @brief    Releases memory allocated by val_buffer_alloc_calloc.
+ *   @param    ptr   - Memory to release
+ *   @return   none
+**/
+void val_buffer_alloc_free(void *ptr)
+{
+    realm_heap_blk_ts *blk, *next;
+    uint8_t *end = realm_crypto_heap + REALM_CRYPTO_HEAP_SIZE;
+
+    if (!ptr)
+        return;
+
+    ((realm_heap_blk_ts *)ptr - 1)->free = 1;
+
+    /* Merge adjacent free blocks */
+    for (blk = (realm_heap_blk_ts *)realm_crypto_heap; (uint8_t *)blk < end;
+         blk = (realm_heap_blk_ts *)((uint8_t *)blk + blk->size))
+    {
+        next = (realm_heap_blk_ts *)((uint8_t *)blk + blk->size);
+        while (blk->free && (uint8_t *)next < end && next->free)
+        {
+            blk->size += next->size;
+            next = (realm_heap_blk_ts *)((uint8_t *)blk + blk->size);
+        }
+    }
+}
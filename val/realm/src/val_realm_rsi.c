@@ -7,6 +7,8 @@
 #include "val_realm_rsi.h"
 #include "val_realm_framework.h"
 #include "val_realm_planes.h"
+#include "val_rhi.h"
+#include "val_libc.h"
 
 __attribute__((aligned (PAGE_SIZE))) static uint8_t realm_config_buff[PAGE_SIZE];
 
@@ -129,6 +131,62 @@ uint64_t val_realm_rsi_rhi_host(val_realm_rsi_host_call_t *rsi_host_call)
      return (val_smc_call(RSI_HOST_CALL, (uint64_t)rsi_host_call, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
 }
 
+/**
+ *   @brief    Read the Firmware Activity Log through a FAL streaming window
+ *   @param    window_ipa   - IPA of the window set up by the host, mapped in stage 1
+ *   @param    dst          - Destination buffer
+ *   @param    dst_size     - Size of the destination buffer
+ *   @param    len          - Pointer to store the number of bytes read
+ *   @return   Returns RHI FAL status code, or RSI_HOST_CALL status on host call failure
+**/
+uint64_t val_realm_rhi_fal_stream_read(uint64_t window_ipa, uint8_t *dst,
+                                        uint64_t dst_size, uint64_t *len)
+{
+    val_rhi_fal_window_ts *win = (val_rhi_fal_window_ts *)window_ipa;
+    uint8_t *ring = (uint8_t *)window_ipa + RHI_FAL_WINDOW_DATA_OFFSET;
+    uint64_t prod, cons, pos, chunk, ret;
+    uint64_t data_size = win->data_size;
+    uint64_t done = 0;
+
+    /* The ring size comes from the host, never divide by a bogus one */
+    if (data_size == 0)
+    {
+        *len = 0;
+        return RHI_FAL_ACCESS_FAILED;
+    }
+
+    do {
+        gv_realm_host_call.imm = 0;
+        gv_realm_host_call.gprs[0] = RHI_FAL_READ;
+        gv_realm_host_call.gprs[1] = window_ipa;
+        gv_realm_host_call.gprs[2] = data_size;
+        ret = val_realm_rsi_rhi_host(&gv_realm_host_call);
+        if (ret)
+            break;
+
+        ret = gv_realm_host_call.gprs[0];
+        if (ret != RHI_FAL_SUCCESS)
+            break;
+
+        /* Drain everything the host published, wrapping at the ring end */
+        prod = __atomic_load_n(&win->prod, __ATOMIC_ACQUIRE);
+        cons = win->cons;
+        while (cons != prod && done < dst_size)
+        {
+            pos = cons % data_size;
+            chunk = MIN(MIN(prod - cons, data_size - pos), dst_size - done);
+            val_memcpy(dst + done, ring + pos, chunk);
+            done += chunk;
+            cons += chunk;
+        }
+        /* Hand the drained bytes back only once they have been read */
+        __atomic_store_n(&win->cons, cons, __ATOMIC_RELEASE);
+    } while (gv_realm_host_call.gprs[2] != 0 && done < dst_size);
+
+    *len = done;
+    return ret;
+}
+
 /**
  *   @brief    Make a host call
  *   @param    imm     - Immediate value
@@ -159,6 +217,33 @@ val_smc_param_ts val_realm_rsi_attestation_token_continue(uint64_t addr, uint64_
     *len = args.x1;
     return args;
 }
+
+/**
+ *   @brief    Retrieve a complete attestation token into a contiguous buffer.
+ *             Issues RSI_ATTESTATION_TOKEN_CONTINUE granule by granule, writing
+ *             straight into the caller buffer until the token is complete.
+ *   @param    buf        - Page aligned buffer spanning one or more granules
+ *   @param    buf_size   - Size of buffer in bytes
+ *   @param    token_size - Pointer to store the token size in bytes
+ *   @return   Returns status of the last RSI_ATTESTATION_TOKEN_CONTINUE
+**/
+uint64_t val_realm_rsi_attestation_token_fetch(uint8_t *buf, uint64_t buf_size,
+                                                uint64_t *token_size)
+{
+    val_smc_param_ts args = {0,};
+    uint64_t done = 0, offset, len;
+
+    do {
+        offset = done % PAGE_SIZE;
+        len = 0;
+        args = val_realm_rsi_attestation_token_continue((uint64_t)(buf + done - offset), offset,
+                                                 MIN(PAGE_SIZE - offset, buf_size - done), &len);
+        done += len;
+    } while (args.x0 == RSI_ERROR_INCOMPLETE && done < buf_size);
+
+    *token_size = done;
+    return args.x0;
+}
 /**
  *   @brief    Initialize the operation to retrieve an attestation token.
  *   @param    challenge_0   - Doubleword 0 of the challenge value